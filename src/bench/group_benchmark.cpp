@@ -0,0 +1,97 @@
+#include "../tiles/group/group_tile.h"
+#include "../tiles/item/item_tile.h"
+#include <QCoreApplication>
+#include <QEvent>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace LongView;
+
+// Eager group with state.range(0) item tiles added one by one
+std::unique_ptr<Tiles::GroupTile> makeGroup(benchmark::State& state)
+{
+    Config::Group group;
+    group.name = "Benchmark";
+    auto groupTile = std::make_unique<Tiles::GroupTile>(group);
+
+    Config::Item item;
+    item.type = Config::Type::Web;
+    item.value = "https://example.com/";
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        item.name = "Item " + std::to_string(i);
+        groupTile->addItemTile(new Tiles::ItemTile(item));
+    }
+    return groupTile;
+}
+
+// Removed tiles are deleted with deleteLater(); count that work too
+void flushDeferredDeletes()
+{
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+
+void BM_GroupTeardown_ClearItemTiles(benchmark::State& state)
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto groupTile = makeGroup(state);
+        state.ResumeTiming();
+
+        groupTile->clearItemTiles();
+        flushDeferredDeletes();
+
+        state.PauseTiming();
+        groupTile.reset();
+        state.ResumeTiming();
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void BM_GroupTeardown_Destroy(benchmark::State& state)
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto groupTile = makeGroup(state);
+        state.ResumeTiming();
+
+        // Child tiles are destroyed with the group, each notifying it on the way
+        groupTile.reset();
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void BM_GroupTeardown_RemoveEach(benchmark::State& state)
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto groupTile = makeGroup(state);
+        const std::vector<Tiles::ItemTile*> tiles = groupTile->itemTiles();
+        state.ResumeTiming();
+
+        // Front to back: the worst case for an index kept as a plain vector
+        for (auto* itemTile : tiles) {
+            groupTile->removeItemTile(itemTile);
+        }
+        flushDeferredDeletes();
+
+        state.PauseTiming();
+        groupTile.reset();
+        state.ResumeTiming();
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+} // namespace
+
+// The fitted complexity is reported; O(N) means O(1) amortized per item
+BENCHMARK(BM_GroupTeardown_ClearItemTiles)->RangeMultiplier(2)->Range(1250, 10000)
+    ->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GroupTeardown_Destroy)->RangeMultiplier(2)->Range(1250, 10000)
+    ->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GroupTeardown_RemoveEach)->RangeMultiplier(2)->Range(1250, 10000)
+    ->Complexity()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,68 @@
+#include "../tiles/item/item_tile.h"
+#include "../theme/theme_manager.h"
+#include <QApplication>
+#include <QFile>
+#include <QWidget>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+
+namespace {
+
+using namespace LongView;
+
+QString tileStyleSheet()
+{
+    QFile f(":/assets/styles/tile.qss");
+    return f.open(QIODevice::ReadOnly) ? QString::fromUtf8(f.readAll()) : QString();
+}
+
+// Construct and polish state.range(0) tiles under one parent, as a dashboard does.
+// With a style sheet, each tile gets its own copy, as Tile::loadStyleSheet() used to do.
+void constructTiles(benchmark::State& state, const QString& perTileStyleSheet)
+{
+    Config::Item item;
+    item.type = Config::Type::Web;
+    item.value = "https://example.com/";
+
+    const int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        auto parent = std::make_unique<QWidget>();
+        for (int i = 0; i < count; ++i) {
+            item.name = "Tile " + std::to_string(i);
+            auto* tile = new Tiles::ItemTile(item, parent.get());
+            if (!perTileStyleSheet.isEmpty()) {
+                tile->setStyleSheet(perTileStyleSheet);
+            }
+            tile->ensurePolished();
+        }
+
+        state.PauseTiming();
+        parent.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+void BM_TileConstruction_ApplicationTheme(benchmark::State& state)
+{
+    Theme::ThemeManager::getInstance().ensureApplied();
+    constructTiles(state, QString());
+}
+
+void BM_TileConstruction_PerTileStyleSheet(benchmark::State& state)
+{
+    // Make sure Tile's own ensureApplied() call is a no-op, then drop the application style sheet
+    Theme::ThemeManager::getInstance().ensureApplied();
+    const QString applied = qApp->styleSheet();
+    qApp->setStyleSheet(QString());
+
+    constructTiles(state, applied.isEmpty() ? tileStyleSheet() : applied);
+
+    qApp->setStyleSheet(applied);
+}
+
+} // namespace
+
+BENCHMARK(BM_TileConstruction_ApplicationTheme)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TileConstruction_PerTileStyleSheet)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
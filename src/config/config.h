@@ -41,6 +41,7 @@ struct Item {
 struct Group {
     std::optional<std::string> name;
     std::vector<Item> items;
+    std::optional<int> max_height;  // in pixels; scroll items within the group when set
 };
 
 // Main configuration structure
@@ -0,0 +1,169 @@
+#include "config_diff.h"
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+namespace LongView {
+namespace Config {
+
+namespace {
+
+bool sameSize(const std::optional<Size>& a, const std::optional<Size>& b) {
+    if (!a || !b) {
+        return !a && !b;
+    }
+    return a->width == b->width && a->height == b->height;
+}
+
+bool sameItem(const Item& a, const Item& b) {
+    return a.name == b.name && a.type == b.type && a.value == b.value &&
+           sameSize(a.size, b.size) && a.refresh_frequency == b.refresh_frequency;
+}
+
+// Items are diffed on their own, so only the group's own properties count
+bool sameGroupProperties(const Group& a, const Group& b) {
+    return a.name == b.name && a.max_height == b.max_height;
+}
+
+std::string itemKey(const Item& item) {
+    if (item.name) {
+        return "n:" + *item.name;
+    }
+    return "v:" + std::to_string(static_cast<int>(item.type)) + ":" + item.value;
+}
+
+std::vector<std::string> groupKeys(const std::vector<Group>& groups) {
+    std::vector<std::string> keys;
+    keys.reserve(groups.size());
+    int unnamed = 0;
+    for (const auto& group : groups) {
+        keys.push_back(group.name ? "n:" + *group.name : "u:" + std::to_string(unnamed++));
+    }
+    return keys;
+}
+
+std::vector<std::string> itemKeys(const std::vector<Item>& items) {
+    std::vector<std::string> keys;
+    keys.reserve(items.size());
+    for (const auto& item : items) {
+        keys.push_back(itemKey(item));
+    }
+    return keys;
+}
+
+// Matched elements outside the longest increasing run of old indices
+std::vector<int> movedIndices(const std::vector<int>& sources) {
+    // Patience sorting: tails[k] is the new index ending the best run of length k + 1
+    std::vector<int> tails;
+    std::vector<int> previous(sources.size(), -1);
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (sources[i] < 0) continue;
+        auto it = std::lower_bound(tails.begin(), tails.end(), sources[i],
+                                   [&sources](int index, int source) { return sources[index] < source; });
+        if (it != tails.begin()) {
+            previous[i] = *std::prev(it);
+        }
+        if (it == tails.end()) {
+            tails.push_back(static_cast<int>(i));
+        } else {
+            *it = static_cast<int>(i);
+        }
+    }
+
+    std::vector<bool> kept(sources.size(), false);
+    for (int i = tails.empty() ? -1 : tails.back(); i >= 0; i = previous[i]) {
+        kept[i] = true;
+    }
+
+    std::vector<int> moved;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (sources[i] >= 0 && !kept[i]) {
+            moved.push_back(static_cast<int>(i));
+        }
+    }
+    return moved;
+}
+
+template <typename T, typename Same>
+ListDiff diffLists(const std::vector<T>& from, const std::vector<std::string>& fromKeys,
+                   const std::vector<T>& to, const std::vector<std::string>& toKeys, Same same) {
+    ListDiff diff;
+
+    std::unordered_map<std::string, std::deque<int>> unmatched;
+    for (size_t i = 0; i < fromKeys.size(); ++i) {
+        unmatched[fromKeys[i]].push_back(static_cast<int>(i));
+    }
+
+    std::vector<bool> matched(from.size(), false);
+    diff.sources.assign(to.size(), -1);
+    for (size_t i = 0; i < to.size(); ++i) {
+        auto it = unmatched.find(toKeys[i]);
+        if (it == unmatched.end() || it->second.empty()) {
+            diff.added.push_back(static_cast<int>(i));
+            continue;
+        }
+        const int source = it->second.front();
+        it->second.pop_front();
+        diff.sources[i] = source;
+        matched[source] = true;
+        if (!same(from[source], to[i])) {
+            diff.modified.push_back(static_cast<int>(i));
+        }
+    }
+
+    for (size_t i = 0; i < from.size(); ++i) {
+        if (!matched[i]) {
+            diff.removed.push_back(static_cast<int>(i));
+        }
+    }
+    diff.moved = movedIndices(diff.sources);
+    return diff;
+}
+
+ListDiff diffItems(const std::vector<Item>& from, const std::vector<Item>& to) {
+    return diffLists(from, itemKeys(from), to, itemKeys(to), sameItem);
+}
+
+} // namespace
+
+bool ListDiff::isModified(int index) const {
+    return std::binary_search(modified.begin(), modified.end(), index);
+}
+
+bool ListDiff::isMoved(int index) const {
+    return std::binary_search(moved.begin(), moved.end(), index);
+}
+
+bool ConfigDiff::isEmpty() const {
+    if (versionChanged || !groups.isEmpty() || !items.isEmpty()) {
+        return false;
+    }
+    return std::all_of(groupItems.begin(), groupItems.end(),
+                       [](const ListDiff& diff) { return diff.isEmpty(); });
+}
+
+ConfigDiff ConfigDiff::compute(const Configuration& from, const Configuration& to) {
+    static const std::vector<Group> noGroups;
+    static const std::vector<Item> noItems;
+    const auto& fromGroups = from.groups ? *from.groups : noGroups;
+    const auto& toGroups = to.groups ? *to.groups : noGroups;
+
+    ConfigDiff diff;
+    diff.versionChanged = from.version != to.version;
+    diff.groups = diffLists(fromGroups, groupKeys(fromGroups), toGroups, groupKeys(toGroups), sameGroupProperties);
+
+    diff.groupItems.resize(toGroups.size());
+    for (size_t i = 0; i < toGroups.size(); ++i) {
+        const int source = diff.groups.sources[i];
+        if (source >= 0) {
+            diff.groupItems[i] = diffItems(fromGroups[source].items, toGroups[i].items);
+        }
+    }
+
+    diff.items = diffItems(from.items ? *from.items : noItems, to.items ? *to.items : noItems);
+    return diff;
+}
+
+} // namespace Config
+} // namespace LongView
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "config.h"
+#include <vector>
+
+namespace LongView {
+namespace Config {
+
+// Difference between two versions of one list of groups or items
+//
+// Elements are matched by identity rather than by position, so reordering
+// or inserting an element does not mark everything after it as changed.
+struct ListDiff {
+    // For each element of the new list, the index of its counterpart in the old list, or -1 if it was added
+    std::vector<int> sources;
+    // Old indices without a counterpart in the new list, ascending
+    std::vector<int> removed;
+    // New indices of added elements, ascending
+    std::vector<int> added;
+    // New indices of matched elements whose content changed, ascending
+    std::vector<int> modified;
+    // New indices of matched elements that changed their order relative to the others, ascending;
+    // as few as possible, i.e. all but the longest run of elements kept in order
+    std::vector<int> moved;
+
+    bool isEmpty() const { return removed.empty() && added.empty() && modified.empty() && moved.empty(); }
+    bool isModified(int index) const;
+    bool isMoved(int index) const;
+};
+
+// Structural difference between two configurations
+//
+// Items are identified by their name, or by type and value when unnamed;
+// groups by their name, or by their position among the unnamed groups.
+// Repeated identities are matched in order of appearance. An item whose
+// name changes is therefore removed and added, while one whose value
+// changes under the same name is modified.
+struct ConfigDiff {
+    bool versionChanged = false;
+    ListDiff groups;                    // Modified groups changed their own properties (max_height)
+    std::vector<ListDiff> groupItems;   // Per new group; empty for added groups
+    ListDiff items;                     // Top-level items
+
+    bool isEmpty() const;
+
+    static ConfigDiff compute(const Configuration& from, const Configuration& to);
+};
+
+} // namespace Config
+} // namespace LongView
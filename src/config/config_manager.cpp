@@ -1,18 +1,69 @@
 #include "config_manager.h"
+#include "config_snapshot.h"
 #include <filesystem>
+#include <fstream>
+#include <optional>
+#include <utility>
 
 namespace LongView {
 namespace Config {
 
+namespace {
+
+std::string readFile(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        throw ConfigFileAccessException("Cannot open file: " + filePath);
+    }
+
+    const std::streamoff size = file.tellg();
+    if (size < 0) {
+        throw ConfigFileAccessException("Cannot read file: " + filePath);
+    }
+    std::string content(static_cast<size_t>(size), '\0');
+    file.seekg(0);
+    file.read(content.data(), static_cast<std::streamsize>(content.size()));
+    return content;
+}
+
+// Hand a complete configuration to a streaming handler
+void replay(const Configuration& config, const ParseHandler& handler) {
+    if (handler.onVersion) {
+        handler.onVersion(config.version);
+    }
+    if (config.groups && handler.onGroup) {
+        for (const auto& group : *config.groups) {
+            handler.onGroup(group);
+        }
+    }
+    if (config.items && handler.onItem) {
+        for (const auto& item : *config.items) {
+            handler.onItem(item);
+        }
+    }
+}
+
+} // namespace
+
 ConfigManager& ConfigManager::getInstance() {
     static ConfigManager instance;
     return instance;
 }
 
-ConfigManager::ConfigManager() : parser_(createConfigParser()) {
+ConfigManager::ConfigManager()
+    : config_(std::make_shared<const Configuration>()), parser_(createConfigParser()) {
 }
 
 void ConfigManager::loadFromFile(const std::string& filePath) {
+    load(filePath, nullptr);
+}
+
+void ConfigManager::loadFromFile(const std::string& filePath, const ParseHandler& handler) {
+    load(filePath, &handler);
+}
+
+void ConfigManager::load(const std::string& filePath, const ParseHandler* handler) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
     try {
         // Check if file exists
         if (!std::filesystem::exists(filePath)) {
@@ -24,27 +75,116 @@ void ConfigManager::loadFromFile(const std::string& filePath) {
             throw ConfigFileEmptyException(filePath);
         }
 
-        // Load configuration using parser
-        config_ = parser_->parseFromFile(filePath);
+        loadContent(filePath, readFile(filePath), handler);
+    } catch (const std::exception& e) {
+        throw ConfigParseException(e.what());
+    }
+}
+
+void ConfigManager::loadContent(const std::string& filePath, const std::string& content,
+                                const ParseHandler* handler) {
+    // Hashing the text is far cheaper than parsing it
+    const ConfigSnapshot::Key key = ConfigSnapshot::makeKey(content, parser_->version());
+    const std::string snapshotPath =
+        snapshotDirectory_.empty() ? std::string() : ConfigSnapshot::pathFor(snapshotDirectory_, filePath);
+
+    loadedFromSnapshot_ = false;
+    std::optional<Configuration> snapshot;
+    if (!snapshotPath.empty()) {
+        snapshot = ConfigSnapshot::load(snapshotPath, key);
+    }
+    if (snapshot) {
+        loadedFromSnapshot_ = true;
+        if (handler) {
+            replay(*snapshot, *handler);
+        }
+        publish(std::move(*snapshot));
+    } else {
+        Configuration config =
+            handler ? parser_->parseFromString(content, *handler) : parser_->parseFromString(content);
+        // Stale or missing: compile for the next start (best effort)
+        if (!snapshotPath.empty()) {
+            ConfigSnapshot::save(snapshotPath, key, config);
+        }
+        publish(std::move(config));
+    }
+
+    sourcePath_ = filePath;
+    sourceHash_ = key.contentHash;
+    sourceSize_ = key.contentSize;
+}
+
+ConfigDiff ConfigManager::reload() {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    if (sourcePath_.empty()) {
+        throw ConfigException("No configuration file loaded");
+    }
+
+    try {
+        const std::string content = readFile(sourcePath_);
+        if (content.empty()) {
+            throw ConfigFileEmptyException(sourcePath_);
+        }
+
+        // Editors often rewrite or touch a file without changing it
+        if (content.size() == sourceSize_ &&
+            ConfigSnapshot::hash(content.data(), content.size()) == sourceHash_) {
+            return ConfigDiff();
+        }
+
+        // Readers may still hold the previous snapshot; so can we, without a copy
+        const ConfigurationPtr previous = getConfiguration();
+        loadContent(sourcePath_, content, nullptr);
+        return ConfigDiff::compute(*previous, *getConfiguration());
+    } catch (const ConfigException&) {
+        throw;
     } catch (const std::exception& e) {
         throw ConfigParseException(e.what());
     }
 }
 
+std::string ConfigManager::sourcePath() const {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return sourcePath_;
+}
+
 void ConfigManager::saveToFile(const std::string& filePath) const {
+    const ConfigurationPtr config = getConfiguration();
+    std::lock_guard<std::mutex> lock(writeMutex_);
     try {
-        parser_->serializeToFile(filePath, config_);
+        parser_->serializeToFile(filePath, *config);
     } catch (const std::exception& e) {
         throw ConfigWriteException(e.what());
     }
 }
 
-const Configuration& ConfigManager::getConfiguration() const {
-    return config_;
+ConfigurationPtr ConfigManager::getConfiguration() const {
+    return std::atomic_load(&config_);
+}
+
+void ConfigManager::updateConfiguration(Configuration config) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    publish(std::move(config));
+}
+
+void ConfigManager::publish(Configuration config) {
+    // Readers holding the old snapshot keep it alive until they let go
+    std::atomic_store(&config_, ConfigurationPtr(std::make_shared<const Configuration>(std::move(config))));
+}
+
+void ConfigManager::setSnapshotDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    snapshotDirectory_ = directory;
+}
+
+std::string ConfigManager::snapshotDirectory() const {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return snapshotDirectory_;
 }
 
-void ConfigManager::updateConfiguration(const Configuration& config) {
-    config_ = config;
+bool ConfigManager::loadedFromSnapshot() const {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return loadedFromSnapshot_;
 }
 
 } // namespace Config
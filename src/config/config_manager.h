@@ -3,12 +3,26 @@
 #include "config.h"
 #include "config_parser.h"
 #include "config_exceptions.h"
+#include "config_diff.h"
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <mutex>
 
 namespace LongView {
 namespace Config {
 
+// Immutable configuration as published by ConfigManager
+using ConfigurationPtr = std::shared_ptr<const Configuration>;
+
+// Owner of the current configuration
+//
+// The configuration is published as immutable, reference-counted snapshots:
+// every load, reload or update builds a new Configuration and swaps the
+// pointer atomically. Readers on any thread take a snapshot with
+// getConfiguration() and keep a consistent view for as long as they hold it;
+// they never wait for a load in progress and never see it half done.
+// Writers are serialized among themselves.
 class ConfigManager {
 public:
     // Singleton pattern
@@ -18,27 +32,61 @@ public:
     ConfigManager(const ConfigManager&) = delete;
     ConfigManager& operator=(const ConfigManager&) = delete;
 
-    // Load configuration from file
+    // Load configuration from file, from its compiled snapshot when that is current
     void loadFromFile(const std::string& filePath);
+
+    // Same, handing each group and top-level item to handler as soon as it is available
+    void loadFromFile(const std::string& filePath, const ParseHandler& handler);
     
+    // Re-read the file of the last loadFromFile() and return what changed; an
+    // unchanged file is not parsed again. On error the current configuration is
+    // kept and the exception propagates.
+    ConfigDiff reload();
+
+    // File of the last successful loadFromFile(); empty before the first one
+    std::string sourcePath() const;
+
     // Save configuration to file
     void saveToFile(const std::string& filePath) const;
     
-    // Get current configuration
-    const Configuration& getConfiguration() const;
+    // Current configuration snapshot; never null, safe to call from any thread
+    ConfigurationPtr getConfiguration() const;
     
-    // Update configuration
-    void updateConfiguration(const Configuration& config);
+    // Publish a new configuration
+    void updateConfiguration(Configuration config);
+
+    // Directory for compiled snapshots of loaded files; empty (the default) disables them
+    void setSnapshotDirectory(const std::string& directory);
+    std::string snapshotDirectory() const;
+
+    // Whether the last loadFromFile() was answered by a snapshot instead of the parser
+    bool loadedFromSnapshot() const;
 
 private:
     // Private constructor for singleton
     ConfigManager();
+
+    void load(const std::string& filePath, const ParseHandler* handler);
+    void loadContent(const std::string& filePath, const std::string& content, const ParseHandler* handler);
+    void publish(Configuration config);
     
-    // Configuration
-    Configuration config_;
+    // Current snapshot; only accessed through std::atomic_load/atomic_store
+    ConfigurationPtr config_;
+
+    // Serializes writers and guards everything below
+    mutable std::mutex writeMutex_;
     
     // Parser instance
     std::unique_ptr<IConfigParser> parser_;
+
+    // Compiled snapshot cache
+    std::string snapshotDirectory_;
+    bool loadedFromSnapshot_ = false;
+
+    // Source of the current configuration, to detect changes on reload
+    std::string sourcePath_;
+    std::uint64_t sourceHash_ = 0;
+    std::uint64_t sourceSize_ = 0;
 };
 
 } // namespace Config
@@ -1,12 +1,22 @@
 #pragma once
 
 #include "config.h"
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <memory>
 
 namespace LongView {
 namespace Config {
 
+// Receives the parts of a configuration as soon as each is complete, in document order;
+// unset callbacks are skipped. On error, parts already delivered are not retracted.
+struct ParseHandler {
+    std::function<void(const std::string& version)> onVersion;
+    std::function<void(const Group& group)> onGroup;
+    std::function<void(const Item& item)> onItem;
+};
+
 // Abstract interface for configuration parsing
 class IConfigParser {
 public:
@@ -20,9 +30,17 @@ public:
     
     // Parse configuration from file
     virtual Configuration parseFromFile(const std::string& filePath) = 0;
+
+    // Parse while streaming each group and top-level item to handler as soon as it is complete;
+    // returns the same configuration and throws the same errors as the non-streaming versions
+    virtual Configuration parseFromString(const std::string& content, const ParseHandler& handler) = 0;
+    virtual Configuration parseFromFile(const std::string& filePath, const ParseHandler& handler) = 0;
     
     // Serialize configuration to file
     virtual void serializeToFile(const std::string& filePath, const Configuration& config) = 0;
+
+    // Version of the parsing rules; compiled snapshots from another version are stale
+    virtual std::uint32_t version() const = 0;
 };
 
 // Factory function to create parser
@@ -0,0 +1,419 @@
+#include "config_snapshot.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace LongView {
+namespace Config {
+
+namespace {
+
+constexpr char kMagic[8] = {'L', 'V', 'C', 'O', 'N', 'F', 'I', 'G'};
+constexpr std::uint32_t kByteOrderMark = 0x01020304;  // Snapshots are written in native byte order
+constexpr const char* kSuffix = ".lvconf";
+
+// Fixed-size header in front of the encoded Configuration
+struct Header {
+    char magic[8];
+    std::uint32_t byteOrder;
+    std::uint32_t formatVersion;
+    std::uint32_t parserVersion;
+    std::uint32_t reserved;
+    std::uint64_t contentHash;
+    std::uint64_t contentSize;
+    std::uint64_t payloadSize;
+    std::uint64_t payloadHash;
+};
+static_assert(sizeof(Header) == 56, "Snapshot header must not contain padding");
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        file_ = CreateFileW(std::filesystem::u8path(path).wstring().c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size) || size.QuadPart <= 0) {
+            return;
+        }
+        mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) {
+            return;
+        }
+        void* view = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+        if (view) {
+            data_ = static_cast<const char*>(view);
+            size_ = static_cast<std::size_t>(size.QuadPart);
+        }
+#else
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            return;
+        }
+        struct stat info;
+        if (::fstat(fd_, &info) != 0 || info.st_size <= 0) {
+            return;
+        }
+        void* view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (view != MAP_FAILED) {
+            data_ = static_cast<const char*>(view);
+            size_ = static_cast<std::size_t>(info.st_size);
+        }
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+        if (fd_ >= 0) ::close(fd_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// Appends fields to the payload
+class Writer {
+public:
+    void writeU8(std::uint8_t value) { buffer_.push_back(static_cast<char>(value)); }
+    void writeU32(std::uint32_t value) { append(&value, sizeof(value)); }
+    void writeI32(std::int32_t value) { append(&value, sizeof(value)); }
+
+    void writeString(const std::string& value) {
+        writeU32(static_cast<std::uint32_t>(value.size()));
+        buffer_.append(value);
+    }
+
+    void writeOptionalString(const std::optional<std::string>& value) {
+        writeU8(value ? 1 : 0);
+        if (value) writeString(*value);
+    }
+
+    void writeOptionalInt(const std::optional<int>& value) {
+        writeU8(value ? 1 : 0);
+        if (value) writeI32(*value);
+    }
+
+    void writeItem(const Item& item) {
+        writeOptionalString(item.name);
+        writeU8(static_cast<std::uint8_t>(item.type));
+        writeString(item.value);
+        writeU8(item.size ? 1 : 0);
+        if (item.size) {
+            writeI32(item.size->width);
+            writeI32(item.size->height);
+        }
+        writeOptionalInt(item.refresh_frequency);
+    }
+
+    void writeItems(const std::vector<Item>& items) {
+        writeU32(static_cast<std::uint32_t>(items.size()));
+        for (const auto& item : items) {
+            writeItem(item);
+        }
+    }
+
+    void writeGroup(const Group& group) {
+        writeOptionalString(group.name);
+        writeOptionalInt(group.max_height);
+        writeItems(group.items);
+    }
+
+    const std::string& buffer() const { return buffer_; }
+
+private:
+    void append(const void* data, std::size_t size) { buffer_.append(static_cast<const char*>(data), size); }
+
+    std::string buffer_;
+};
+
+// Decodes the payload; any out-of-bounds read marks the whole snapshot invalid
+class Reader {
+public:
+    Reader(const char* data, std::size_t size) : pos_(data), end_(data + size) {}
+
+    bool ok() const { return ok_; }
+    bool atEnd() const { return pos_ == end_; }
+
+    std::uint8_t readU8() {
+        std::uint8_t value = 0;
+        take(&value, sizeof(value));
+        return value;
+    }
+
+    std::uint32_t readU32() {
+        std::uint32_t value = 0;
+        take(&value, sizeof(value));
+        return value;
+    }
+
+    std::int32_t readI32() {
+        std::int32_t value = 0;
+        take(&value, sizeof(value));
+        return value;
+    }
+
+    std::string readString() {
+        const std::uint32_t length = readU32();
+        if (!ok_ || length > remaining()) {
+            ok_ = false;
+            return std::string();
+        }
+        std::string value(pos_, length);
+        pos_ += length;
+        return value;
+    }
+
+    std::optional<std::string> readOptionalString() {
+        if (readU8() == 0) return std::nullopt;
+        return readString();
+    }
+
+    std::optional<int> readOptionalInt() {
+        if (readU8() == 0) return std::nullopt;
+        return readI32();
+    }
+
+    Item readItem() {
+        Item item;
+        item.name = readOptionalString();
+        const std::uint8_t type = readU8();
+        if (type > static_cast<std::uint8_t>(Type::Image)) {
+            ok_ = false;
+        }
+        item.type = static_cast<Type>(type);
+        item.value = readString();
+        if (readU8() != 0) {
+            Size size;
+            size.width = readI32();
+            size.height = readI32();
+            item.size = size;
+        }
+        item.refresh_frequency = readOptionalInt();
+        return item;
+    }
+
+    std::vector<Item> readItems() {
+        std::vector<Item> items;
+        const std::uint32_t count = readU32();
+        // Every item takes several bytes; a count beyond that is corruption
+        if (!ok_ || count > remaining()) {
+            ok_ = false;
+            return items;
+        }
+        items.reserve(count);
+        for (std::uint32_t i = 0; i < count && ok_; ++i) {
+            items.push_back(readItem());
+        }
+        return items;
+    }
+
+    Group readGroup() {
+        Group group;
+        group.name = readOptionalString();
+        group.max_height = readOptionalInt();
+        group.items = readItems();
+        return group;
+    }
+
+    std::vector<Group> readGroups() {
+        std::vector<Group> groups;
+        const std::uint32_t count = readU32();
+        if (!ok_ || count > remaining()) {
+            ok_ = false;
+            return groups;
+        }
+        groups.reserve(count);
+        for (std::uint32_t i = 0; i < count && ok_; ++i) {
+            groups.push_back(readGroup());
+        }
+        return groups;
+    }
+
+private:
+    std::size_t remaining() const { return static_cast<std::size_t>(end_ - pos_); }
+
+    void take(void* out, std::size_t size) {
+        if (!ok_ || size > remaining()) {
+            ok_ = false;
+            return;
+        }
+        std::memcpy(out, pos_, size);
+        pos_ += size;
+    }
+
+    const char* pos_;
+    const char* end_;
+    bool ok_ = true;
+};
+
+} // namespace
+
+std::uint64_t ConfigSnapshot::hash(const char* data, std::size_t size) {
+    std::uint64_t value = 14695981039346656037ull;
+    for (std::size_t i = 0; i < size; ++i) {
+        value ^= static_cast<unsigned char>(data[i]);
+        value *= 1099511628211ull;
+    }
+    return value;
+}
+
+ConfigSnapshot::Key ConfigSnapshot::makeKey(const std::string& content, std::uint32_t parserVersion) {
+    Key key;
+    key.contentHash = hash(content.data(), content.size());
+    key.contentSize = content.size();
+    key.parserVersion = parserVersion;
+    return key;
+}
+
+std::string ConfigSnapshot::pathFor(const std::string& directory, const std::string& sourcePath) {
+    // One snapshot per source file; the readable stem only helps when browsing the cache
+    std::error_code error;
+    std::filesystem::path source = std::filesystem::absolute(sourcePath, error);
+    if (error) {
+        source = sourcePath;
+    }
+    const std::string sourceKey = source.lexically_normal().string();
+
+    std::ostringstream name;
+    name << std::filesystem::path(sourcePath).stem().string() << '-' << std::hex << std::setw(16)
+         << std::setfill('0') << hash(sourceKey.data(), sourceKey.size()) << kSuffix;
+    return (std::filesystem::path(directory) / name.str()).string();
+}
+
+std::optional<Configuration> ConfigSnapshot::load(const std::string& path, const Key& key) {
+    MappedFile file(path);
+    if (!file.data() || file.size() < sizeof(Header)) {
+        return std::nullopt;
+    }
+
+    Header header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0
+        || header.byteOrder != kByteOrderMark
+        || header.formatVersion != kFormatVersion
+        || header.parserVersion != key.parserVersion
+        || header.contentHash != key.contentHash
+        || header.contentSize != key.contentSize
+        || header.payloadSize != file.size() - sizeof(Header)) {
+        return std::nullopt;
+    }
+
+    const char* payload = file.data() + sizeof(Header);
+    const std::size_t payloadSize = static_cast<std::size_t>(header.payloadSize);
+    if (hash(payload, payloadSize) != header.payloadHash) {
+        return std::nullopt;
+    }
+
+    Reader reader(payload, payloadSize);
+    Configuration config;
+    config.version = reader.readString();
+    if (reader.readU8() != 0) {
+        config.groups = reader.readGroups();
+    }
+    if (reader.readU8() != 0) {
+        config.items = reader.readItems();
+    }
+    if (!reader.ok() || !reader.atEnd()) {
+        return std::nullopt;
+    }
+    return config;
+}
+
+bool ConfigSnapshot::save(const std::string& path, const Key& key, const Configuration& config) {
+    Writer writer;
+    writer.writeString(config.version);
+    writer.writeU8(config.groups ? 1 : 0);
+    if (config.groups) {
+        writer.writeU32(static_cast<std::uint32_t>(config.groups->size()));
+        for (const auto& group : *config.groups) {
+            writer.writeGroup(group);
+        }
+    }
+    writer.writeU8(config.items ? 1 : 0);
+    if (config.items) {
+        writer.writeItems(*config.items);
+    }
+    const std::string& payload = writer.buffer();
+
+    Header header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.byteOrder = kByteOrderMark;
+    header.formatVersion = kFormatVersion;
+    header.parserVersion = key.parserVersion;
+    header.reserved = 0;
+    header.contentHash = key.contentHash;
+    header.contentSize = key.contentSize;
+    header.payloadSize = payload.size();
+    header.payloadHash = hash(payload.data(), payload.size());
+
+    std::error_code error;
+    const std::filesystem::path target(path);
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), error);
+        if (error) {
+            return false;
+        }
+    }
+
+    // Readers must never see a partially written snapshot
+    const std::filesystem::path temporary = target.string() + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        if (!file.flush()) {
+            file.close();
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+    }
+    std::filesystem::rename(temporary, target, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+} // namespace Config
+} // namespace LongView
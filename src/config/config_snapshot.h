@@ -0,0 +1,50 @@
+#pragma once
+
+#include "config.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace LongView {
+namespace Config {
+
+// Compiled binary form of a Configuration, cached to skip YAML parsing at startup
+//
+// A snapshot is keyed by the hash and size of the YAML text it was compiled
+// from and by the version of the parser that compiled it, so any edit of the
+// file or change of the parser makes it stale. Snapshots are memory-mapped
+// and decoded in a single pass over length-prefixed fields; the only work
+// left is building the strings and vectors of the Configuration itself.
+//
+// Loading never throws: a missing, stale or damaged snapshot is reported as
+// a miss and the caller parses the YAML instead.
+class ConfigSnapshot {
+public:
+    // Bump when the binary layout changes
+    static constexpr std::uint32_t kFormatVersion = 1;
+
+    // Identity of the source a snapshot was compiled from
+    struct Key {
+        std::uint64_t contentHash = 0;
+        std::uint64_t contentSize = 0;
+        std::uint32_t parserVersion = 0;
+    };
+
+    static Key makeKey(const std::string& content, std::uint32_t parserVersion);
+
+    // Snapshot file in directory for the configuration file at sourcePath
+    static std::string pathFor(const std::string& directory, const std::string& sourcePath);
+
+    // Decode the snapshot at path if it was compiled from the source matching key
+    static std::optional<Configuration> load(const std::string& path, const Key& key);
+
+    // Write a snapshot atomically, creating its directory; false on failure
+    static bool save(const std::string& path, const Key& key, const Configuration& config);
+
+    // 64-bit FNV-1a; not cryptographic, only used to detect changes
+    static std::uint64_t hash(const char* data, std::size_t size);
+};
+
+} // namespace Config
+} // namespace LongView
@@ -1,10 +1,527 @@
 #include "yaml_config_parser.h"
+#include <yaml-cpp/eventhandler.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <functional>
+#include <mutex>
 #include <sstream>
+#include <streambuf>
+#include <thread>
+#include <vector>
 
 namespace LongView {
 namespace Config {
 
+namespace {
+
+std::string readFile(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        throw ConfigFileAccessException("Cannot open file: " + filePath);
+    }
+
+    // Read in one go; streaming through a stringstream copies the file twice
+    const std::streamoff size = file.tellg();
+    if (size < 0) {
+        throw ConfigFileAccessException("Cannot read file: " + filePath);
+    }
+    std::string content(static_cast<size_t>(size), '\0');
+    file.seekg(0);
+    file.read(content.data(), static_cast<std::streamsize>(content.size()));
+    return content;
+}
+
+// Smallest share of a parallel conversion worth a thread of its own
+constexpr size_t kGroupsPerThread = 1;
+constexpr size_t kItemsPerThread = 64;
+
+// Elements of a groups or items node, in document order
+std::vector<YAML::Node> children(const YAML::Node& node) {
+    std::vector<YAML::Node> result;
+    if (!node) return result;
+    result.reserve(node.size());
+    for (const auto& child : node) {
+        result.push_back(child);
+    }
+    return result;
+}
+
+// Worker threads shared by all parallel conversions, started on first use
+//
+// Tasks run in the order they are posted. Tasks never wait for each other,
+// so concurrent parses on different threads just share the workers.
+class WorkerPool {
+public:
+    WorkerPool() {
+        // The thread that posts work takes part in it as well
+        const unsigned count = std::max(1u, std::thread::hardware_concurrency()) - 1;
+        for (unsigned i = 0; i < count; ++i) {
+            threads_.emplace_back([this]() { run(); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wakeup_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    size_t size() const { return threads_.size(); }
+
+    void post(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        wakeup_.notify_one();
+    }
+
+private:
+    void run() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wakeup_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) return;
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::deque<std::function<void()>> tasks_;
+    bool stopping_ = false;
+};
+
+WorkerPool& workerPool() {
+    static WorkerPool pool;
+    return pool;
+}
+
+// Converts independent subtrees on the worker pool; the calling thread takes part
+//
+// results[i] is the conversion of nodes[i]. Returns false as soon as any
+// conversion fails; the caller then redoes them in order to report the
+// first error deterministically. Each thread gets at least nodesPerThread
+// nodes, so small lists are not worth a thread.
+//
+// yaml-cpp does not document concurrent reads as safe, so every conversion
+// only reads inside the subtree of its own node; the node list itself is
+// collected by the caller beforehand. Conversions must go through const
+// Nodes: the non-const operator[] adds missing keys to the memory shared by
+// the whole document. The const paths they use (operator[] with string keys,
+// as<>, size(), iteration, Mark()) only touch the nodes they are called on,
+// and the one value yaml-cpp caches lazily, the length of a sequence,
+// belongs to a node of that subtree. The shared memory holder is only
+// copied, as a shared_ptr. Checked against yaml-cpp 0.7.
+template <typename T, typename Convert>
+bool convertInParallel(const std::vector<YAML::Node>& nodes, size_t nodesPerThread, std::vector<T>& results,
+                       Convert convert) {
+    results.resize(nodes.size());
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    auto work = [&]() {
+        for (size_t i = next++; i < nodes.size() && !failed; i = next++) {
+            try {
+                results[i] = convert(nodes[i]);
+            } catch (...) {
+                failed = true;
+            }
+        }
+    };
+
+    WorkerPool& pool = workerPool();
+    const size_t threadCount = std::max<size_t>(1, std::min(nodes.size() / nodesPerThread, pool.size() + 1));
+
+    // Helpers that start late find no nodes left, but are still waited for
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t pending = threadCount - 1;
+    for (size_t i = 1; i < threadCount; ++i) {
+        pool.post([&]() {
+            work();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) {
+                done.notify_one();
+            }
+        });
+    }
+    work();
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&]() { return pending == 0; });
+    return !failed;
+}
+
+// Lets YAML::Parser read a string without copying it into a stream first
+class StringBuffer : public std::streambuf {
+public:
+    explicit StringBuffer(const std::string& content) {
+        char* begin = const_cast<char*>(content.data());
+        setg(begin, begin, begin + content.size());
+    }
+};
+
+} // namespace
+
+// Turns parser events into configuration parts while the document is being read
+//
+// No YAML::Node tree is built: the events of each group and top-level item
+// are assembled straight into a Group or Item, validated with the regular
+// validateGroup()/validateItem() and handed out as soon as their last event
+// arrives. Only well-formed documents in the usual shape are taken this way.
+// Anything else (aliases, duplicate keys, values of the wrong kind, errors)
+// throws Unsupported, and the caller finishes with the document parser, which
+// accepts or reports it exactly as parseFromString() does.
+class YamlConfigParser::StreamBuilder : public YAML::EventHandler {
+public:
+    // The document needs the document parser from here on
+    struct Unsupported {};
+
+    StreamBuilder(const YamlConfigParser& parser, const ParseHandler& handler, Configuration& config)
+        : parser_(parser), handler_(handler), config_(config) {}
+
+    bool hasVersion() const { return hasVersion_; }
+    bool handlerFailed() const { return handlerFailed_; }
+
+    // Parts already handed out, so a fallback can continue after them
+    bool versionEmitted() const { return versionEmitted_; }
+    size_t groupsEmitted() const { return groupsEmitted_; }
+    size_t itemsEmitted() const { return itemsEmitted_; }
+
+    void OnDocumentStart(const YAML::Mark&) override {}
+    void OnDocumentEnd() override {}
+
+    void OnNull(const YAML::Mark&, YAML::anchor_t) override {
+        if (skipDepth_ > 0) return;
+        // Null is never a valid value of a known key or a list element
+        if (stack_.empty() || !stack_.back().hasKey || known(stack_.back())) {
+            throw Unsupported();
+        }
+        stack_.back().hasKey = false;
+    }
+
+    void OnAlias(const YAML::Mark&, YAML::anchor_t) override {
+        if (skipDepth_ > 0) return;
+        throw Unsupported();
+    }
+
+    void OnScalar(const YAML::Mark&, const std::string&, YAML::anchor_t, const std::string& value) override {
+        if (skipDepth_ > 0) return;
+        if (stack_.empty() || !isMap(stack_.back().context)) {
+            throw Unsupported();
+        }
+
+        Frame& frame = stack_.back();
+        if (!frame.hasKey) {
+            frame.key = value;
+            frame.hasKey = true;
+            claimKey(frame);
+            return;
+        }
+        frame.hasKey = false;
+
+        switch (frame.context) {
+        case Context::Root:
+            if (frame.key == "version") {
+                config_.version = value;
+                parser_.validateVersion(config_.version);
+                hasVersion_ = true;
+                versionEmitted_ = true;
+                notify(handler_.onVersion, config_.version);
+            } else if (known(frame)) {
+                throw Unsupported();
+            }
+            break;
+        case Context::Group:
+            if (frame.key == "name") {
+                group_.name = value;
+            } else if (frame.key == "max_height") {
+                group_.max_height = toInt(value);
+            } else if (known(frame)) {
+                throw Unsupported();
+            }
+            break;
+        case Context::Item:
+            if (frame.key == "name") {
+                item_.name = value;
+            } else if (frame.key == "type") {
+                auto it = typeMap.find(value);
+                if (it == typeMap.end()) {
+                    throw Unsupported();
+                }
+                item_.type = it->second;
+                hasType_ = true;
+            } else if (frame.key == "value") {
+                item_.value = value;
+                hasValue_ = true;
+            } else if (frame.key == "refresh_frequency") {
+                item_.refresh_frequency = toInt(value);
+            } else if (known(frame)) {
+                throw Unsupported();
+            }
+            break;
+        case Context::Size:
+            if (frame.key == "width") {
+                size_.width = toInt(value);
+                hasWidth_ = true;
+            } else if (frame.key == "height") {
+                size_.height = toInt(value);
+                hasHeight_ = true;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void OnSequenceStart(const YAML::Mark&, const std::string&, YAML::anchor_t,
+                         YAML::EmitterStyle::value) override {
+        if (skipDepth_ > 0) {
+            ++skipDepth_;
+            return;
+        }
+        const Context context = valueContext(true);
+        if (context == Context::Groups) {
+            config_.groups = std::vector<Group>();
+        } else if (context == Context::Items) {
+            config_.items = std::vector<Item>();
+        }
+        enter(context);
+    }
+
+    void OnSequenceEnd() override {
+        leave();
+    }
+
+    void OnMapStart(const YAML::Mark&, const std::string&, YAML::anchor_t, YAML::EmitterStyle::value) override {
+        if (skipDepth_ > 0) {
+            ++skipDepth_;
+            return;
+        }
+        if (stack_.empty()) {
+            stack_.emplace_back(Context::Root);
+            return;
+        }
+
+        const Context context = valueContext(false);
+        if (context == Context::Group) {
+            group_ = Group();
+        } else if (context == Context::Item) {
+            item_ = Item();
+            hasType_ = false;
+            hasValue_ = false;
+        } else if (context == Context::Size) {
+            hasWidth_ = false;
+            hasHeight_ = false;
+        }
+        enter(context);
+    }
+
+    void OnMapEnd() override {
+        leave();
+    }
+
+private:
+    enum class Context {
+        Root,        // The top-level map
+        Groups,      // groups: [...]
+        Group,       // One element of groups
+        GroupItems,  // items: [...] of a group
+        Items,       // Top-level items: [...]
+        Item,        // One element of either items list
+        Size,        // size: {width, height} of an item
+        Skip         // A value nobody reads
+    };
+
+    // Open map or sequence; maps alternate between expecting a key and its value
+    struct Frame {
+        explicit Frame(Context context) : context(context) {}
+
+        Context context;
+        std::string key;
+        bool hasKey = false;
+        std::vector<std::string> keys;  // Known keys seen so far
+    };
+
+    static bool isMap(Context context) {
+        return context == Context::Root || context == Context::Group || context == Context::Item
+            || context == Context::Size;
+    }
+
+    // Whether frame's current key is one the parser reads
+    static bool known(const Frame& frame) {
+        const std::string& key = frame.key;
+        switch (frame.context) {
+        case Context::Root:
+            return key == "version" || key == "groups" || key == "items";
+        case Context::Group:
+            return key == "name" || key == "max_height" || key == "items";
+        case Context::Item:
+            return key == "name" || key == "type" || key == "value" || key == "size" || key == "refresh_frequency";
+        case Context::Size:
+            return key == "width" || key == "height";
+        default:
+            return false;
+        }
+    }
+
+    // The document parser reads the first of duplicate keys; leave those cases to it
+    static void claimKey(Frame& frame) {
+        if (!known(frame)) return;
+        for (const auto& key : frame.keys) {
+            if (key == frame.key) {
+                throw Unsupported();
+            }
+        }
+        frame.keys.push_back(frame.key);
+    }
+
+    static int toInt(const std::string& value) {
+        try {
+            return YAML::Node(value).as<int>();
+        } catch (const YAML::Exception&) {
+            throw Unsupported();
+        }
+    }
+
+    // Context of a map or sequence value starting at the current position
+    Context valueContext(bool sequence) {
+        if (stack_.empty()) {
+            throw Unsupported();
+        }
+        Frame& frame = stack_.back();
+        if (!isMap(frame.context)) {
+            // List element: groups and items hold maps only
+            if (sequence) throw Unsupported();
+            return frame.context == Context::Groups ? Context::Group : Context::Item;
+        }
+        if (!frame.hasKey) {
+            throw Unsupported();  // Complex key
+        }
+        if (!known(frame)) {
+            return Context::Skip;
+        }
+
+        if (sequence && frame.context == Context::Root && frame.key != "version") {
+            return frame.key == "groups" ? Context::Groups : Context::Items;
+        }
+        if (sequence && frame.context == Context::Group && frame.key == "items") {
+            return Context::GroupItems;
+        }
+        if (!sequence && frame.context == Context::Item && frame.key == "size") {
+            return Context::Size;
+        }
+        throw Unsupported();
+    }
+
+    void enter(Context context) {
+        if (context == Context::Skip) {
+            skipDepth_ = 1;
+            return;
+        }
+        stack_.emplace_back(context);
+    }
+
+    void leave() {
+        if (skipDepth_ > 0) {
+            if (--skipDepth_ == 0) {
+                stack_.back().hasKey = false;
+            }
+            return;
+        }
+
+        const Context context = stack_.back().context;
+        stack_.pop_back();
+        if (!stack_.empty() && isMap(stack_.back().context)) {
+            stack_.back().hasKey = false;
+        }
+
+        switch (context) {
+        case Context::Root:
+            if (!hasVersion_) {
+                throw Unsupported();
+            }
+            break;
+        case Context::Group:
+            parser_.validateGroup(group_);
+            config_.groups->push_back(std::move(group_));
+            ++groupsEmitted_;
+            notify(handler_.onGroup, config_.groups->back());
+            break;
+        case Context::Item:
+            if (!hasType_ || !hasValue_) {
+                throw Unsupported();
+            }
+            parser_.validateItem(item_);
+            if (stack_.back().context == Context::GroupItems) {
+                group_.items.push_back(std::move(item_));
+            } else {
+                config_.items->push_back(std::move(item_));
+                ++itemsEmitted_;
+                notify(handler_.onItem, config_.items->back());
+            }
+            break;
+        case Context::Size:
+            if (!hasWidth_ || !hasHeight_) {
+                throw Unsupported();
+            }
+            item_.size = size_;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Handler exceptions must not be mistaken for parse errors
+    template <typename Callback, typename Value>
+    void notify(const Callback& callback, const Value& value) {
+        if (!callback) return;
+        try {
+            callback(value);
+        } catch (...) {
+            handlerFailed_ = true;
+            throw;
+        }
+    }
+
+    const YamlConfigParser& parser_;
+    const ParseHandler& handler_;
+    Configuration& config_;
+    std::vector<Frame> stack_;
+    int skipDepth_ = 0;
+
+    // Parts under construction; groups and items do not nest
+    Group group_;
+    Item item_;
+    Size size_{};
+    bool hasType_ = false;
+    bool hasValue_ = false;
+    bool hasWidth_ = false;
+    bool hasHeight_ = false;
+
+    bool hasVersion_ = false;
+    bool handlerFailed_ = false;
+    bool versionEmitted_ = false;
+    size_t groupsEmitted_ = 0;
+    size_t itemsEmitted_ = 0;
+};
+
 void YamlConfigParser::trackNode(const std::string& type, const std::string& name, const YAML::Node& node) const {
     lastParsedNode_ = {
         type,
@@ -67,6 +584,28 @@ Configuration YamlConfigParser::parseFromString(const std::string& content) {
         validateVersion(config.version);
         trackNode("version", "version", node["version"]);
         
+        // Convert group and item subtrees in parallel; results keep document order
+        const YAML::Node groupsNode = node["groups"];
+        const YAML::Node itemsNode = node["items"];
+        const std::vector<YAML::Node> groupNodes = children(groupsNode);
+        const std::vector<YAML::Node> itemNodes = children(itemsNode);
+        std::vector<Group> groups;
+        std::vector<Item> items;
+        // Every task gets its own parser, so the tracked nodes are never shared between threads
+        const bool converted =
+            convertInParallel(groupNodes, kGroupsPerThread, groups, [](const YAML::Node& groupNode) {
+                return YamlConfigParser().parseGroup(groupNode);
+            })
+            && convertInParallel(itemNodes, kItemsPerThread, items, [](const YAML::Node& itemNode) {
+                return YamlConfigParser().parseItem(itemNode);
+            });
+        if (converted) {
+            if (groupsNode) config.groups = std::move(groups);
+            if (itemsNode) config.items = std::move(items);
+            return config;
+        }
+
+        // Something failed: redo it in document order, which reports the first error exactly as before
         // Parse groups
         if (node["groups"]) {
             config.groups = std::vector<Group>();
@@ -128,14 +667,44 @@ std::string YamlConfigParser::serializeToString(const Configuration& config) {
 }
 
 Configuration YamlConfigParser::parseFromFile(const std::string& filePath) {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        throw ConfigFileAccessException("Cannot open file: " + filePath);
+    return parseFromString(readFile(filePath));
+}
+
+Configuration YamlConfigParser::parseFromString(const std::string& content, const ParseHandler& handler) {
+    Configuration config;
+    StreamBuilder builder(*this, handler, config);
+    try {
+        StringBuffer buffer(content);
+        std::istream input(&buffer);
+        YAML::Parser parser(input);
+        parser.HandleNextDocument(builder);
+        if (builder.hasVersion()) {
+            return config;
+        }
+    } catch (...) {
+        if (builder.handlerFailed()) throw;
     }
-    
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return parseFromString(buffer.str());
+
+    // Unusual shape or an error: the document parser accepts or reports it with line information
+    config = parseFromString(content);
+    if (!builder.versionEmitted() && handler.onVersion) {
+        handler.onVersion(config.version);
+    }
+    if (config.groups && handler.onGroup) {
+        for (size_t i = builder.groupsEmitted(); i < config.groups->size(); ++i) {
+            handler.onGroup((*config.groups)[i]);
+        }
+    }
+    if (config.items && handler.onItem) {
+        for (size_t i = builder.itemsEmitted(); i < config.items->size(); ++i) {
+            handler.onItem((*config.items)[i]);
+        }
+    }
+    return config;
+}
+
+Configuration YamlConfigParser::parseFromFile(const std::string& filePath, const ParseHandler& handler) {
+    return parseFromString(readFile(filePath), handler);
 }
 
 void YamlConfigParser::serializeToFile(const std::string& filePath, const Configuration& config) {
@@ -155,6 +724,11 @@ Group YamlConfigParser::parseGroup(const YAML::Node& node) const {
         trackNode("group", *group.name, node["name"]);
     }
     
+    // Parse optional nested scroll height
+    if (node["max_height"]) {
+        group.max_height = node["max_height"].as<int>();
+    }
+    
     if (node["items"]) {
         for (const auto& itemNode : node["items"]) {
             try {
@@ -183,6 +757,10 @@ YAML::Node YamlConfigParser::serializeGroup(const Group& group) const {
     }
     
     node["items"] = itemsNode;
+    
+    if (group.max_height) {
+        node["max_height"] = *group.max_height;
+    }
     return node;
 }
 
@@ -279,9 +857,10 @@ void YamlConfigParser::validateGroup(const Group& group) const {
         throw ConfigException("Group must contain at least one item");
     }
     
-    for (const auto& item : group.items) {
-        validateItem(item);
+    if (group.max_height && *group.max_height <= 0) {
+        throw ConfigException("Group max height must be positive");
     }
+    // Items were validated by parseItem() already
 }
 
 void YamlConfigParser::validateVersion(const std::string& version) const {
@@ -9,12 +9,21 @@ namespace Config {
 
 class YamlConfigParser : public IConfigParser {
 public:
+    // Bump whenever parsing or validation changes what a file yields
+    static constexpr std::uint32_t kVersion = 1;
+
     Configuration parseFromString(const std::string& content) override;
     std::string serializeToString(const Configuration& config) override;
     Configuration parseFromFile(const std::string& filePath) override;
+    Configuration parseFromString(const std::string& content, const ParseHandler& handler) override;
+    Configuration parseFromFile(const std::string& filePath, const ParseHandler& handler) override;
     void serializeToFile(const std::string& filePath, const Configuration& config) override;
+    std::uint32_t version() const override { return kVersion; }
 
 private:
+    // Builds group and item subtrees from parser events for the streaming parse
+    class StreamBuilder;
+
     // Internal helper methods
     Item parseItem(const YAML::Node& node) const;
     YAML::Node serializeItem(const Item& item) const;
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace LongView {
+namespace Content {
+
+/**
+ * @brief Shared flag telling background work that its result is no longer wanted
+ *
+ * Copies share one flag, so a token can be handed to worker tasks while its
+ * owner keeps a copy to cancel them. Cancellation is cooperative: work checks
+ * isCancelled() before each expensive step. Thread-safe.
+ */
+class CancellationToken {
+public:
+    CancellationToken()
+        : m_cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() const { m_cancelled->store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return m_cancelled->load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+} // namespace Content
+} // namespace LongView
@@ -0,0 +1,158 @@
+#include "content_cache.h"
+
+#include <QMutexLocker>
+#include <algorithm>
+#include <iterator>
+
+namespace LongView {
+namespace Content {
+
+namespace {
+    // Rough per-entry overhead (key strings, list node, hash slot)
+    constexpr qint64 kEntryOverhead = 256;
+}
+
+ContentCache& ContentCache::getInstance()
+{
+    static ContentCache instance;
+    return instance;
+}
+
+ContentCache::ContentCache()
+{
+    // Allow sizing the cache without code changes
+    bool ok = false;
+    const int megabytes = qEnvironmentVariableIntValue("LONGVIEW_CONTENT_CACHE_MB", &ok);
+    if (ok && megabytes >= 0) {
+        m_maxBytes = static_cast<qint64>(megabytes) * 1024 * 1024;
+    }
+}
+
+QImage ContentCache::find(const Key& key)
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_index.constFind(keyString(key));
+    if (it == m_index.constEnd()) {
+        ++m_statistics.misses;
+        return QImage();
+    }
+
+    ++m_statistics.hits;
+    m_entries.splice(m_entries.begin(), m_entries, it.value());
+    return it.value()->image;
+}
+
+bool ContentCache::contains(const Key& key) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_index.contains(keyString(key));
+}
+
+void ContentCache::insert(const Key& key, const QImage& image)
+{
+    if (image.isNull()) return;
+
+    const QString keyText = keyString(key);
+    const qint64 bytes = costOf(image);
+
+    QMutexLocker locker(&m_mutex);
+    auto it = m_index.find(keyText);
+    if (it != m_index.end()) {
+        eraseLocked(it.value());
+    }
+    if (bytes > m_maxBytes) return;
+
+    m_entries.push_front({keyText, key.source, image, bytes});
+    m_index.insert(keyText, m_entries.begin());
+    m_bytes += bytes;
+    ++m_statistics.insertions;
+    evictLocked();
+}
+
+void ContentCache::remove(const Key& key)
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_index.find(keyString(key));
+    if (it != m_index.end()) {
+        eraseLocked(it.value());
+    }
+}
+
+void ContentCache::removeSource(const QString& source)
+{
+    QMutexLocker locker(&m_mutex);
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        auto current = it++;
+        if (current->source == source) {
+            eraseLocked(current);
+        }
+    }
+}
+
+void ContentCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+    m_index.clear();
+    m_bytes = 0;
+}
+
+void ContentCache::setMaxBytes(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maxBytes = std::max<qint64>(0, bytes);
+    evictLocked();
+}
+
+qint64 ContentCache::maxBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_maxBytes;
+}
+
+ContentCache::Statistics ContentCache::statistics() const
+{
+    QMutexLocker locker(&m_mutex);
+    Statistics result = m_statistics;
+    result.bytes = m_bytes;
+    result.entries = static_cast<int>(m_index.size());
+    return result;
+}
+
+void ContentCache::resetStatistics()
+{
+    QMutexLocker locker(&m_mutex);
+    m_statistics = Statistics();
+}
+
+QString ContentCache::keyString(const Key& key)
+{
+    return QStringLiteral("%1:%2x%3:%4")
+        .arg(key.kind == Kind::Image ? 'i' : 's')
+        .arg(key.size.width())
+        .arg(key.size.height())
+        .arg(key.source);
+}
+
+qint64 ContentCache::costOf(const QImage& image)
+{
+    return image.sizeInBytes() + kEntryOverhead;
+}
+
+void ContentCache::eraseLocked(EntryList::iterator it)
+{
+    m_bytes -= it->bytes;
+    m_index.remove(it->key);
+    m_entries.erase(it);
+}
+
+void ContentCache::evictLocked()
+{
+    while (m_bytes > m_maxBytes && !m_entries.empty()) {
+        eraseLocked(std::prev(m_entries.end()));
+        ++m_statistics.evictions;
+    }
+}
+
+} // namespace Content
+} // namespace LongView
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+#include <list>
+
+namespace LongView {
+namespace Content {
+
+/**
+ * @brief Process-wide, byte-bounded LRU cache of decoded tile content
+ *
+ * Entries are keyed by source (URL or path), target size and kind, so the
+ * same chart shown at two sizes is cached twice, while tiles showing it at
+ * the same size share one decoded image. When the byte budget is exceeded
+ * the least recently used entries are evicted. All methods are thread-safe.
+ */
+class ContentCache {
+public:
+    static constexpr qint64 kDefaultMaxBytes = 128ll * 1024 * 1024;
+
+    enum class Kind { Image, Snapshot };
+
+    struct Key {
+        Kind kind = Kind::Image;
+        QString source;
+        QSize size;  // Target size in device pixels; invalid for full size
+    };
+
+    struct Statistics {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 insertions = 0;
+        quint64 evictions = 0;
+        qint64 bytes = 0;
+        int entries = 0;
+    };
+
+    // Singleton pattern
+    static ContentCache& getInstance();
+
+    ContentCache(const ContentCache&) = delete;
+    ContentCache& operator=(const ContentCache&) = delete;
+
+    /**
+     * @brief Look up an entry and mark it most recently used
+     * @return The cached image, or a null QImage on a miss
+     */
+    QImage find(const Key& key);
+    bool contains(const Key& key) const;
+
+    /**
+     * @brief Insert or replace an entry, evicting old entries as needed
+     *
+     * Images larger than the whole budget are not cached.
+     */
+    void insert(const Key& key, const QImage& image);
+    void remove(const Key& key);
+
+    /**
+     * @brief Drop every entry for @p source, at any size and of any kind
+     */
+    void removeSource(const QString& source);
+    void clear();
+
+    void setMaxBytes(qint64 bytes);
+    qint64 maxBytes() const;
+
+    Statistics statistics() const;
+    void resetStatistics();
+
+private:
+    ContentCache();
+
+    struct Entry {
+        QString key;
+        QString source;
+        QImage image;
+        qint64 bytes;
+    };
+    using EntryList = std::list<Entry>;
+
+    static QString keyString(const Key& key);
+    static qint64 costOf(const QImage& image);
+    void eraseLocked(EntryList::iterator it);
+    void evictLocked();
+
+    mutable QMutex m_mutex;
+    EntryList m_entries;  // Most recently used first
+    QHash<QString, EntryList::iterator> m_index;
+    qint64 m_maxBytes = kDefaultMaxBytes;
+    qint64 m_bytes = 0;
+    Statistics m_statistics;
+};
+
+} // namespace Content
+} // namespace LongView
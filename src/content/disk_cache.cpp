@@ -0,0 +1,460 @@
+#include "disk_cache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtEndian>
+#include <algorithm>
+#include <vector>
+
+namespace LongView {
+namespace Content {
+
+namespace {
+    // Fixed prefix: magic, version, kind, header size, header checksum
+    constexpr quint32 kMagic = 0x4C564331;  // "LVC1"
+    constexpr quint16 kFormatVersion = 1;
+    constexpr qint64 kPrefixSize = 16;
+    constexpr qint64 kPayloadAlignment = 16;
+    constexpr const char* kFileSuffix = ".lvc";
+
+    // After trimming, stay this far below the cap so eviction does not run on every write
+    constexpr double kTrimTarget = 0.9;
+
+    qint64 alignUp(qint64 value)
+    {
+        return (value + kPayloadAlignment - 1) / kPayloadAlignment * kPayloadAlignment;
+    }
+
+    quint32 checksum(const char* data, qint64 size)
+    {
+        return qChecksum(QByteArrayView(data, size));
+    }
+}
+
+DiskCache& DiskCache::getInstance()
+{
+    static DiskCache instance;
+    return instance;
+}
+
+DiskCache::DiskCache()
+    : m_directory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/content")
+{
+    // Allow sizing the cache without code changes
+    bool ok = false;
+    const int megabytes = qEnvironmentVariableIntValue("LONGVIEW_DISK_CACHE_MB", &ok);
+    if (ok && megabytes >= 0) {
+        m_maxBytes = static_cast<qint64>(megabytes) * 1024 * 1024;
+    }
+}
+
+std::optional<DiskCache::Payload> DiskCache::readPayload(const QString& source)
+{
+    std::optional<Payload> result;
+    readEntry(fileName(Kind::Payload, source, QSize()), Kind::Payload, source, true,
+               [&result](const Header& header, const char* data) {
+        Payload payload;
+        payload.data = QByteArray(data, static_cast<qsizetype>(header.payloadSize));
+        payload.validators = header.validators;
+        payload.storedAt = QDateTime::fromMSecsSinceEpoch(header.storedAt);
+        result = std::move(payload);
+    });
+    return result;
+}
+
+std::optional<DiskCache::Validators> DiskCache::readValidators(const QString& source)
+{
+    std::optional<Validators> result;
+    // Header only; the payload is checked when it is actually read
+    readEntry(fileName(Kind::Payload, source, QSize()), Kind::Payload, source, false,
+               [&result](const Header& header, const char*) {
+        result = header.validators;
+    });
+    return result;
+}
+
+bool DiskCache::storePayload(const QString& source, const QByteArray& data, const Validators& validators)
+{
+    Header header;
+    header.kind = Kind::Payload;
+    header.validators = validators;
+    if (header.validators.contentHash.isEmpty()) {
+        header.validators.contentHash = contentHash(data);
+    }
+    header.source = source;
+
+    return writeEntry(fileName(Kind::Payload, source, QSize()), header, data.constData(), data.size());
+}
+
+QImage DiskCache::readSnapshot(const QString& source, const QSize& size, Validators* validators)
+{
+    QImage result;
+    readEntry(fileName(Kind::Snapshot, source, size), Kind::Snapshot, source, true,
+               [&](const Header& header, const char* data) {
+        const auto format = static_cast<QImage::Format>(header.format);
+        if (format <= QImage::Format_Invalid || format >= QImage::NImageFormats) return;
+        if (header.width <= 0 || header.height <= 0 || header.bytesPerLine <= 0) return;
+        if (static_cast<quint64>(header.bytesPerLine) * static_cast<quint64>(header.height) > header.payloadSize) return;
+
+        // Wrap the mapped pixels, then copy once so the file can be replaced
+        // while the image is in use; no decoding involved
+        const QImage mapped(reinterpret_cast<const uchar*>(data), header.width, header.height,
+                            header.bytesPerLine, format);
+        result = mapped.copy();
+        if (validators) {
+            *validators = header.validators;
+        }
+    });
+    return result;
+}
+
+bool DiskCache::storeSnapshot(const QString& source, const QSize& size, const QImage& image, const Validators& validators)
+{
+    if (image.isNull()) return false;
+
+    Header header;
+    header.kind = Kind::Snapshot;
+    header.validators = validators;
+    header.source = source;
+    header.width = image.width();
+    header.height = image.height();
+    header.bytesPerLine = static_cast<qint32>(image.bytesPerLine());
+    header.format = static_cast<qint32>(image.format());
+
+    const QString name = fileName(Kind::Snapshot, source, size);
+
+    // Refreshes usually render unchanged content; skip rewriting identical snapshots
+    if (!validators.contentHash.isEmpty()) {
+        bool unchanged = false;
+        readEntry(name, Kind::Snapshot, source, false, [&](const Header& existing, const char*) {
+            unchanged = existing.validators.contentHash == validators.contentHash
+                     && existing.width == header.width && existing.height == header.height;
+        });
+        if (unchanged) return true;
+    }
+
+    return writeEntry(name, header, reinterpret_cast<const char*>(image.constBits()), image.sizeInBytes());
+}
+
+void DiskCache::remove(const QString& source)
+{
+    QStringList names;
+    {
+        QMutexLocker locker(&m_mutex);
+        ensureIndexLocked();
+        names = m_index.keys();
+    }
+
+    // Snapshot file names depend on the size; find them through their headers
+    const QString payloadName = fileName(Kind::Payload, source, QSize());
+    for (const QString& name : names) {
+        bool matches = name == payloadName;
+        if (!matches) {
+            readEntry(name, Kind::Snapshot, source, false, [&matches](const Header&, const char*) {
+                matches = true;
+            });
+        }
+        if (matches) {
+            QMutexLocker locker(&m_mutex);
+            discardLocked(name, false);
+        }
+    }
+}
+
+void DiskCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    ensureIndexLocked();
+    const QStringList names = m_index.keys();
+    for (const QString& name : names) {
+        discardLocked(name, false);
+    }
+}
+
+void DiskCache::setDirectory(const QString& path)
+{
+    QMutexLocker locker(&m_mutex);
+    m_directory = path;
+    m_index.clear();
+    m_totalBytes = 0;
+    m_indexed = false;
+}
+
+QString DiskCache::directory() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_directory;
+}
+
+void DiskCache::setMaxBytes(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maxBytes = std::max<qint64>(0, bytes);
+    trimLocked();
+}
+
+qint64 DiskCache::maxBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_maxBytes;
+}
+
+DiskCache::Statistics DiskCache::statistics() const
+{
+    QMutexLocker locker(&m_mutex);
+    Statistics result = m_statistics;
+    result.bytes = m_totalBytes;
+    result.entries = static_cast<int>(m_index.size());
+    return result;
+}
+
+QByteArray DiskCache::contentHash(const QByteArray& data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+QString DiskCache::fileName(Kind kind, const QString& source, const QSize& size)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::number(static_cast<int>(kind)));
+    hash.addData("\n", 1);
+    hash.addData(source.toUtf8());
+    if (kind == Kind::Snapshot) {
+        hash.addData(QStringLiteral("\n%1x%2").arg(size.width()).arg(size.height()).toUtf8());
+    }
+    return QString::fromLatin1(hash.result().toHex()) + kFileSuffix;
+}
+
+QString DiskCache::filePathLocked(const QString& name) const
+{
+    return m_directory + '/' + name;
+}
+
+bool DiskCache::writeEntry(const QString& name, const Header& header, const char* data, qint64 size)
+{
+    QString directory;
+    {
+        QMutexLocker locker(&m_mutex);
+        ensureIndexLocked();
+        // A single entry may not take over the whole cache
+        if (size > m_maxBytes / 8) return false;
+        directory = m_directory;
+    }
+    if (!QDir().mkpath(directory)) return false;
+
+    // Variable part of the header
+    QByteArray fields;
+    {
+        QDataStream stream(&fields, QIODevice::WriteOnly);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        stream.setVersion(QDataStream::Qt_6_0);
+        stream << static_cast<qint64>(QDateTime::currentMSecsSinceEpoch())
+               << static_cast<quint64>(size)
+               << QCryptographicHash::hash(QByteArray::fromRawData(data, static_cast<qsizetype>(size)), QCryptographicHash::Sha1)
+               << header.validators.etag
+               << header.validators.lastModified
+               << header.validators.contentHash
+               << header.source
+               << header.width << header.height << header.bytesPerLine << header.format;
+    }
+    const qint64 headerSize = alignUp(kPrefixSize + fields.size());
+    fields.append(QByteArray(static_cast<qsizetype>(headerSize - kPrefixSize - fields.size()), '\0'));
+
+    char prefix[kPrefixSize] = {};
+    qToLittleEndian<quint32>(kMagic, prefix);
+    qToLittleEndian<quint16>(kFormatVersion, prefix + 4);
+    qToLittleEndian<quint16>(static_cast<quint16>(header.kind), prefix + 6);
+    qToLittleEndian<quint32>(static_cast<quint32>(headerSize), prefix + 8);
+    qToLittleEndian<quint32>(checksum(fields.constData(), fields.size()), prefix + 12);
+
+    // Written to a temporary file and renamed, so readers never see partial
+    // entries and readers still mapping the old file keep reading it intact
+    QSaveFile file(directory + '/' + name);
+    if (!file.open(QIODevice::WriteOnly)
+        || file.write(prefix, kPrefixSize) != kPrefixSize
+        || file.write(fields) != fields.size()
+        || file.write(data, size) != size
+        || !file.commit()) {
+        qWarning() << "Failed to write disk cache entry" << file.fileName() << file.errorString();
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    // The cache moved to another directory meanwhile; the file is not part of it
+    if (directory != m_directory) return false;
+
+    IndexEntry& entry = m_index[name];
+    m_totalBytes += headerSize + size - entry.bytes;
+    entry.bytes = headerSize + size;
+    entry.lastUsed = QDateTime::currentMSecsSinceEpoch();
+    entry.generation = ++m_nextGeneration;
+    ++m_statistics.writes;
+    trimLocked();
+    return true;
+}
+
+template <typename Consumer>
+bool DiskCache::readEntry(const QString& name, Kind kind, const QString& source, bool verifyPayload, Consumer&& consume)
+{
+    QString path;
+    quint64 generation = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        ensureIndexLocked();
+        auto it = m_index.constFind(name);
+        if (it == m_index.constEnd()) {
+            ++m_statistics.misses;
+            return false;
+        }
+        path = filePathLocked(name);
+        generation = it->generation;
+    }
+
+    const ReadResult result = readFile(path, kind, source, verifyPayload, std::forward<Consumer>(consume));
+
+    QMutexLocker locker(&m_mutex);
+    if (result == ReadResult::Hit) {
+        ++m_statistics.hits;
+        touchLocked(name);
+        return true;
+    }
+    ++m_statistics.misses;
+
+    // Only drop the file that was read; a writer may have replaced it since
+    if (result == ReadResult::Unreadable || result == ReadResult::Corrupted) {
+        auto it = m_index.constFind(name);
+        if (it != m_index.constEnd() && it->generation == generation && filePathLocked(name) == path) {
+            discardLocked(name, result == ReadResult::Corrupted);
+        }
+    }
+    return false;
+}
+
+template <typename Consumer>
+DiskCache::ReadResult DiskCache::readFile(const QString& path, Kind kind, const QString& source,
+                                          bool verifyPayload, Consumer&& consume)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return ReadResult::Unreadable;
+
+    const qint64 fileSize = file.size();
+    const uchar* mapped = fileSize >= kPrefixSize ? file.map(0, fileSize) : nullptr;
+    if (!mapped) return ReadResult::Corrupted;
+
+    const char* bytes = reinterpret_cast<const char*>(mapped);
+    const qint64 headerSize = qFromLittleEndian<quint32>(bytes + 8);
+    if (qFromLittleEndian<quint32>(bytes) != kMagic
+        || qFromLittleEndian<quint16>(bytes + 4) != kFormatVersion
+        || headerSize < kPrefixSize || headerSize > fileSize
+        || qFromLittleEndian<quint32>(bytes + 12) != checksum(bytes + kPrefixSize, headerSize - kPrefixSize)) {
+        return ReadResult::Corrupted;
+    }
+
+    // A different kind under this name is a hash collision, not corruption
+    if (qFromLittleEndian<quint16>(bytes + 6) != static_cast<quint16>(kind)) {
+        return ReadResult::Miss;
+    }
+
+    Header header;
+    header.kind = kind;
+    {
+        const QByteArray fields = QByteArray::fromRawData(bytes + kPrefixSize, headerSize - kPrefixSize);
+        QDataStream stream(fields);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        stream.setVersion(QDataStream::Qt_6_0);
+        stream >> header.storedAt >> header.payloadSize >> header.payloadHash
+               >> header.validators.etag >> header.validators.lastModified >> header.validators.contentHash
+               >> header.source
+               >> header.width >> header.height >> header.bytesPerLine >> header.format;
+        if (stream.status() != QDataStream::Ok) return ReadResult::Corrupted;
+    }
+    if (static_cast<quint64>(fileSize - headerSize) != header.payloadSize) return ReadResult::Corrupted;
+
+    const char* payload = bytes + headerSize;
+    if (verifyPayload
+        && QCryptographicHash::hash(QByteArray::fromRawData(payload, static_cast<qsizetype>(header.payloadSize)),
+                                    QCryptographicHash::Sha1) != header.payloadHash) {
+        return ReadResult::Corrupted;
+    }
+    if (header.source != source) return ReadResult::Miss;
+
+    // The mapping lives as long as the file object
+    consume(header, payload);
+    return ReadResult::Hit;
+}
+
+void DiskCache::discardLocked(const QString& name, bool corrupted)
+{
+    if (corrupted) {
+        ++m_statistics.corruptions;
+        qWarning() << "Discarding corrupted disk cache entry" << name;
+    }
+    QFile::remove(filePathLocked(name));
+    auto it = m_index.find(name);
+    if (it != m_index.end()) {
+        m_totalBytes -= it->bytes;
+        m_index.erase(it);
+    }
+}
+
+void DiskCache::touchLocked(const QString& name)
+{
+    auto it = m_index.find(name);
+    if (it != m_index.end()) {
+        it->lastUsed = QDateTime::currentMSecsSinceEpoch();
+    }
+}
+
+void DiskCache::ensureIndexLocked()
+{
+    if (m_indexed) return;
+    m_indexed = true;
+
+    // Last use from a previous run is approximated by the modification time
+    const QFileInfoList files = QDir(m_directory).entryInfoList(
+        {QStringLiteral("*") + kFileSuffix}, QDir::Files);
+    for (const QFileInfo& info : files) {
+        IndexEntry& entry = m_index[info.fileName()];
+        entry.bytes = info.size();
+        entry.lastUsed = info.lastModified().toMSecsSinceEpoch();
+        m_totalBytes += entry.bytes;
+    }
+
+    // Leftovers of interrupted writes
+    const QFileInfoList temporaries = QDir(m_directory).entryInfoList(
+        {QStringLiteral("*") + kFileSuffix + ".*"}, QDir::Files);
+    for (const QFileInfo& info : temporaries) {
+        QFile::remove(info.absoluteFilePath());
+    }
+
+    trimLocked();
+}
+
+void DiskCache::trimLocked()
+{
+    if (m_totalBytes <= m_maxBytes) return;
+
+    std::vector<std::pair<qint64, QString>> byAge;
+    byAge.reserve(m_index.size());
+    for (auto it = m_index.constBegin(); it != m_index.constEnd(); ++it) {
+        byAge.emplace_back(it->lastUsed, it.key());
+    }
+    std::sort(byAge.begin(), byAge.end());
+
+    const qint64 target = static_cast<qint64>(static_cast<double>(m_maxBytes) * kTrimTarget);
+    for (const auto& [lastUsed, name] : byAge) {
+        if (m_totalBytes <= target) break;
+        discardLocked(name, false);
+        ++m_statistics.evictions;
+    }
+}
+
+} // namespace Content
+} // namespace LongView
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+#include <optional>
+
+namespace LongView {
+namespace Content {
+
+/**
+ * @brief Persistent cache of fetched payloads and rendered snapshots
+ *
+ * Lives in the application's cache directory and survives restarts, so a
+ * dashboard can paint the content of its last run before anything has been
+ * fetched. One file per entry: a small checksummed header (validators,
+ * content hash, image geometry) followed by the raw payload at a 16-byte
+ * aligned offset. Files are read through QFile::map(), so snapshots are
+ * restored with a single copy of their pixels and no image decoding.
+ *
+ * Every read verifies the header checksum and the payload hash; damaged or
+ * truncated files are deleted and reported as misses. The total size is
+ * capped and the least recently used files are evicted first. Files are
+ * written atomically. All methods are thread-safe and meant to be called
+ * from worker threads. The lock only guards the index: files are read,
+ * verified and written outside it, so workers do disk I/O in parallel.
+ */
+class DiskCache {
+public:
+    static constexpr qint64 kDefaultMaxBytes = 256ll * 1024 * 1024;
+
+    /**
+     * @brief HTTP validators and content hash of a fetched payload
+     */
+    struct Validators {
+        QByteArray etag;
+        QByteArray lastModified;
+        QByteArray contentHash;  // SHA-1 of the payload the entry came from
+    };
+
+    struct Payload {
+        QByteArray data;
+        Validators validators;
+        QDateTime storedAt;
+    };
+
+    struct Statistics {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 writes = 0;
+        quint64 evictions = 0;
+        quint64 corruptions = 0;
+        qint64 bytes = 0;
+        int entries = 0;
+    };
+
+    // Singleton pattern
+    static DiskCache& getInstance();
+
+    DiskCache(const DiskCache&) = delete;
+    DiskCache& operator=(const DiskCache&) = delete;
+
+    // Last fetched payload per source
+    std::optional<Payload> readPayload(const QString& source);
+    std::optional<Validators> readValidators(const QString& source);
+    bool storePayload(const QString& source, const QByteArray& data, const Validators& validators);
+
+    // Last rendered snapshot per source and size (device pixels)
+    QImage readSnapshot(const QString& source, const QSize& size, Validators* validators = nullptr);
+    bool storeSnapshot(const QString& source, const QSize& size, const QImage& image, const Validators& validators);
+
+    void remove(const QString& source);
+    void clear();
+
+    /**
+     * @brief Use a different directory (e.g. for a separate profile); drops the index
+     */
+    void setDirectory(const QString& path);
+    QString directory() const;
+
+    void setMaxBytes(qint64 bytes);
+    qint64 maxBytes() const;
+
+    Statistics statistics() const;
+
+    static QByteArray contentHash(const QByteArray& data);
+
+private:
+    DiskCache();
+
+    enum class Kind : quint16 { Payload = 1, Snapshot = 2 };
+
+    struct Header {
+        Kind kind = Kind::Payload;
+        qint64 storedAt = 0;
+        quint64 payloadSize = 0;
+        QByteArray payloadHash;  // SHA-1 of the bytes stored after the header
+        Validators validators;
+        QString source;
+        qint32 width = 0;
+        qint32 height = 0;
+        qint32 bytesPerLine = 0;
+        qint32 format = 0;
+    };
+
+    struct IndexEntry {
+        qint64 bytes = 0;
+        qint64 lastUsed = 0;
+        quint64 generation = 0;  // Changes whenever the file is rewritten
+    };
+
+    enum class ReadResult { Hit, Miss, Unreadable, Corrupted };
+
+    static QString fileName(Kind kind, const QString& source, const QSize& size);
+    QString filePathLocked(const QString& name) const;
+
+    bool writeEntry(const QString& name, const Header& header, const char* data, qint64 size);
+    // Looks the entry up in the index, then reads it without holding the lock
+    template <typename Consumer>
+    bool readEntry(const QString& name, Kind kind, const QString& source, bool verifyPayload, Consumer&& consume);
+    // Maps the file and validates it; calls @p consume with header and payload
+    template <typename Consumer>
+    static ReadResult readFile(const QString& path, Kind kind, const QString& source, bool verifyPayload,
+                               Consumer&& consume);
+    void discardLocked(const QString& name, bool corrupted);
+    void touchLocked(const QString& name);
+    void ensureIndexLocked();
+    void trimLocked();
+
+    mutable QMutex m_mutex;
+    QString m_directory;
+    qint64 m_maxBytes = kDefaultMaxBytes;
+    qint64 m_totalBytes = 0;
+    bool m_indexed = false;
+    quint64 m_nextGeneration = 0;
+    QHash<QString, IndexEntry> m_index;  // File name -> size and last use
+    Statistics m_statistics;
+};
+
+} // namespace Content
+} // namespace LongView
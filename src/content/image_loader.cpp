@@ -0,0 +1,425 @@
+#include "image_loader.h"
+#include "content_cache.h"
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QThread>
+#include <QThreadPool>
+#include <QUrl>
+#include <algorithm>
+
+namespace LongView {
+namespace Content {
+
+namespace {
+    // Leave cores for the GUI thread and the rest of the application
+    int workerCount()
+    {
+        return std::clamp(QThread::idealThreadCount() / 2, 2, 8);
+    }
+
+    // Map "file:" and "qrc:" URLs to paths QImageReader can open
+    QString localPath(const QString& source)
+    {
+        if (source.startsWith(":/")) return source;
+        const QUrl url(source);
+        if (url.isLocalFile()) return url.toLocalFile();
+        if (url.scheme() == "qrc") return ":" + url.path();
+        return source;
+    }
+
+    QImage read(QImageReader& reader, const QSize& targetSize, QString* errorString)
+    {
+        reader.setAutoTransform(true);
+
+        // Let the image plugin decode at the target size (JPEG decodes at
+        // 1/2, 1/4 or 1/8 scale directly); never upscale
+        const QSize original = reader.size();
+        if (targetSize.isValid() && original.isValid()
+            && (original.width() > targetSize.width() || original.height() > targetSize.height())) {
+            reader.setScaledSize(original.scaled(targetSize, Qt::KeepAspectRatio).expandedTo(QSize(1, 1)));
+        }
+
+        QImage image = reader.read();
+        if (image.isNull() && errorString) {
+            *errorString = reader.errorString();
+        }
+        return image;
+    }
+}
+
+ImageReply::ImageReply(quint64 job, const QString& source, const QSize& targetSize, Network::Priority priority,
+                       QObject* parent)
+    : QObject(parent)
+    , m_job(job)
+    , m_source(source)
+    , m_targetSize(targetSize)
+    , m_priority(priority)
+{
+}
+
+ImageReply::~ImageReply()
+{
+    abort();
+}
+
+void ImageReply::abort()
+{
+    if (m_finished) return;
+    m_finished = true;
+    ImageLoader::getInstance().forget(this);
+}
+
+void ImageReply::setPriority(Network::Priority priority)
+{
+    if (priority == m_priority) return;
+    m_priority = priority;
+    if (!m_finished) {
+        ImageLoader::getInstance().reprioritize(m_job);
+    }
+}
+
+void ImageReply::finish(const QImage& image, const QString& errorString, bool stale)
+{
+    if (m_finished) return;
+    m_finished = true;
+    m_image = image;
+    m_errorString = errorString;
+    m_stale = stale;
+    emit finished();
+}
+
+ImageLoader& ImageLoader::getInstance()
+{
+    static ImageLoader instance;
+    return instance;
+}
+
+ImageLoader::ImageLoader()
+    : QObject(nullptr)
+    , m_threadPool(new QThreadPool(this))
+{
+    m_threadPool->setMaxThreadCount(workerCount());
+
+    // Workers post back to this object's event loop; stop them while it runs
+    if (auto* app = QCoreApplication::instance()) {
+        connect(app, &QCoreApplication::aboutToQuit, this, &ImageLoader::shutdown);
+    }
+}
+
+ImageLoader::~ImageLoader()
+{
+    // Workers post back to this object; let them finish first
+    m_threadPool->waitForDone();
+}
+
+void ImageLoader::shutdown()
+{
+    m_shuttingDown = true;
+
+    // Pending replies are not notified; their jobs are simply gone
+    for (Job& job : m_jobs) {
+        job.token.cancel();
+        Network::FetchReply* fetchReply = job.fetchReply;
+        delete fetchReply;
+    }
+    m_jobs.clear();
+    m_jobsByKey.clear();
+
+    m_threadPool->clear();
+    m_threadPool->waitForDone();
+}
+
+ImageReply* ImageLoader::load(const QString& source, const QSize& targetSize, QObject* parent,
+                              CachePolicy policy, Network::Priority priority)
+{
+    if (m_shuttingDown) {
+        // Never finishes; nothing is loaded while the application quits
+        return new ImageReply(++m_nextId, source, targetSize, priority, parent);
+    }
+
+    if (policy == CachePolicy::PreferCache) {
+        const QImage cached = ContentCache::getInstance().find({ContentCache::Kind::Image, source, targetSize});
+        if (!cached.isNull()) {
+            const quint64 id = ++m_nextId;
+            auto* reply = new ImageReply(id, source, targetSize, priority, parent);
+            m_jobs[id].replies.append(reply);
+            // Still asynchronous, so callers can connect to finished() first
+            QMetaObject::invokeMethod(this, [this, id, cached]() {
+                deliver(id, cached, QString());
+            }, Qt::QueuedConnection);
+            return reply;
+        }
+    }
+
+    // Join a job for the same image that is already in flight; a refreshing
+    // job also satisfies a PreferCache load
+    const QString refreshKey = jobKey(source, targetSize, CachePolicy::Refresh);
+    auto joined = m_jobsByKey.constFind(refreshKey);
+    if (joined == m_jobsByKey.constEnd() && policy == CachePolicy::PreferCache) {
+        joined = m_jobsByKey.constFind(jobKey(source, targetSize, policy));
+    }
+    if (joined != m_jobsByKey.constEnd()) {
+        auto* reply = new ImageReply(joined.value(), source, targetSize, priority, parent);
+        m_jobs[joined.value()].replies.append(reply);
+        ++m_coalesced;
+        reprioritize(joined.value());
+        return reply;
+    }
+
+    const quint64 id = ++m_nextId;
+    auto* reply = new ImageReply(id, source, targetSize, priority, parent);
+    Job& job = m_jobs[id];
+    job.key = jobKey(source, targetSize, policy);
+    job.replies.append(reply);
+    job.priority = priority;
+    m_jobsByKey.insert(job.key, id);
+
+    const bool remote = Network::FetchEngine::isRemote(QUrl(source));
+    m_threadPool->start([this, id, source, targetSize, policy, remote, token = job.token]() {
+        if (token.isCancelled()) return;
+
+        // Last run's snapshot paints immediately; the caller revalidates it
+        if (policy == CachePolicy::PreferCache) {
+            const QImage snapshot = DiskCache::getInstance().readSnapshot(source, targetSize);
+            if (!snapshot.isNull()) {
+                ContentCache::getInstance().insert({ContentCache::Kind::Image, source, targetSize}, snapshot);
+                QMetaObject::invokeMethod(this, [this, id, snapshot]() {
+                    deliver(id, snapshot, QString(), true);
+                }, Qt::QueuedConnection);
+                return;
+            }
+        }
+
+        if (!remote) {
+            loadLocal(id, source, targetSize, token);
+            return;
+        }
+
+        // Network requests are issued from the GUI thread
+        const auto validators = DiskCache::getInstance().readValidators(source);
+        QMetaObject::invokeMethod(this, [this, id, source, targetSize, validators]() {
+            if (isPending(id)) {
+                startDownload(id, source, targetSize, validators);
+            }
+        }, Qt::QueuedConnection);
+    }, poolPriority(id));
+    return reply;
+}
+
+QImage ImageLoader::decode(const QByteArray& data, const QSize& targetSize, QString* errorString)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer);
+    return read(reader, targetSize, errorString);
+}
+
+QImage ImageLoader::decodeFile(const QString& path, const QSize& targetSize, QString* errorString)
+{
+    if (!QFileInfo::exists(path)) {
+        if (errorString) *errorString = tr("File not found: %1").arg(path);
+        return QImage();
+    }
+    QImageReader reader(path);
+    return read(reader, targetSize, errorString);
+}
+
+QString ImageLoader::jobKey(const QString& source, const QSize& targetSize, CachePolicy policy)
+{
+    // Concatenated: chained arg() would expand %N markers inside the URL itself
+    return source + '\n' + QString::number(targetSize.width()) + 'x' + QString::number(targetSize.height())
+         + '\n' + QChar(policy == CachePolicy::Refresh ? 'R' : 'C');
+}
+
+void ImageLoader::reprioritize(quint64 id)
+{
+    auto it = m_jobs.find(id);
+    if (it == m_jobs.end()) return;
+
+    Job& job = it.value();
+    Network::Priority priority = Network::Priority::Prefetch;
+    for (const QPointer<ImageReply>& reply : job.replies) {
+        if (reply && !reply->isFinished()) {
+            priority = std::min(priority, reply->priority());
+        }
+    }
+    job.priority = priority;
+    if (job.fetchReply) {
+        job.fetchReply->setPriority(priority);
+    }
+}
+
+int ImageLoader::poolPriority(quint64 id) const
+{
+    // QThreadPool runs higher numbers first
+    const auto it = m_jobs.constFind(id);
+    const auto priority = it != m_jobs.constEnd() ? it->priority : Network::Priority::Prefetch;
+    return static_cast<int>(Network::Priority::Prefetch) - static_cast<int>(priority);
+}
+
+void ImageLoader::loadLocal(quint64 id, const QString& source, const QSize& targetSize,
+                            const CancellationToken& token)
+{
+    // Runs on a worker; the bytes are hashed so unchanged files keep their snapshot
+    QString error;
+    QImage image;
+    QFile file(localPath(source));
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = tr("Cannot open %1: %2").arg(file.fileName(), file.errorString());
+    } else {
+        const QByteArray data = file.readAll();
+        if (token.isCancelled()) return;
+        image = decode(data, targetSize, &error);
+        if (!image.isNull()) {
+            DiskCache::Validators validators;
+            validators.contentHash = DiskCache::contentHash(data);
+            DiskCache::getInstance().storeSnapshot(source, targetSize, image, validators);
+            ContentCache::getInstance().insert({ContentCache::Kind::Image, source, targetSize}, image);
+        }
+    }
+
+    QMetaObject::invokeMethod(this, [this, id, image, error]() {
+        deliver(id, image, error);
+    }, Qt::QueuedConnection);
+}
+
+void ImageLoader::startDownload(quint64 id, const QString& source, const QSize& targetSize,
+                                const std::optional<DiskCache::Validators>& validators)
+{
+    // Conditional request: unchanged content comes back as 304 without a body
+    Network::Validators requestValidators;
+    if (validators) {
+        requestValidators.etag = validators->etag;
+        requestValidators.lastModified = validators->lastModified;
+    }
+
+    Network::FetchReply* fetchReply = Network::FetchEngine::getInstance().fetch(
+        QUrl(source), requestValidators, this, m_jobs.value(id).priority);
+    m_jobs[id].fetchReply = fetchReply;
+    connect(fetchReply, &Network::FetchReply::finished, this, [this, fetchReply, id, source, targetSize, validators]() {
+        onDownloadFinished(fetchReply, id, source, targetSize, validators);
+    });
+}
+
+void ImageLoader::onDownloadFinished(Network::FetchReply* fetchReply, quint64 id, const QString& source,
+                                     const QSize& targetSize, const std::optional<DiskCache::Validators>& validators)
+{
+    fetchReply->deleteLater();
+    if (!isPending(id)) return;
+    m_jobs[id].fetchReply = nullptr;
+
+    if (fetchReply->hasError()) {
+        deliver(id, QImage(), fetchReply->errorString());
+        return;
+    }
+
+    if (fetchReply->isNotModified() && validators) {
+        m_threadPool->start([this, id, source, targetSize, validators, token = m_jobs.value(id).token]() {
+            if (token.isCancelled()) return;
+
+            // Unchanged: reuse the snapshot if it was rendered from this payload
+            DiskCache::Validators snapshotValidators;
+            QImage image = DiskCache::getInstance().readSnapshot(source, targetSize, &snapshotValidators);
+            if (image.isNull() || snapshotValidators.contentHash != validators->contentHash) {
+                const auto payload = DiskCache::getInstance().readPayload(source);
+                if (!payload) {
+                    // The stored payload vanished; fetch it unconditionally
+                    QMetaObject::invokeMethod(this, [this, id, source, targetSize]() {
+                        if (isPending(id)) {
+                            startDownload(id, source, targetSize, std::nullopt);
+                        }
+                    }, Qt::QueuedConnection);
+                    return;
+                }
+                if (token.isCancelled()) return;
+                QString error;
+                image = decode(payload->data, targetSize, &error);
+                if (image.isNull()) {
+                    QMetaObject::invokeMethod(this, [this, id, error]() {
+                        deliver(id, QImage(), error);
+                    }, Qt::QueuedConnection);
+                    return;
+                }
+                DiskCache::getInstance().storeSnapshot(source, targetSize, image, payload->validators);
+            }
+            ContentCache::getInstance().insert({ContentCache::Kind::Image, source, targetSize}, image);
+            QMetaObject::invokeMethod(this, [this, id, image]() {
+                deliver(id, image, QString());
+            }, Qt::QueuedConnection);
+        }, poolPriority(id));
+        return;
+    }
+
+    DiskCache::Validators fresh;
+    fresh.etag = fetchReply->validators().etag;
+    fresh.lastModified = fetchReply->validators().lastModified;
+    decodeAsync(id, source, fetchReply->data(), targetSize, fresh);
+}
+
+void ImageLoader::decodeAsync(quint64 id, const QString& source, const QByteArray& data, const QSize& targetSize,
+                              const DiskCache::Validators& validators)
+{
+    m_threadPool->start([this, id, source, data, targetSize, validators, token = m_jobs.value(id).token]() {
+        if (token.isCancelled()) return;
+
+        QString error;
+        const QImage image = decode(data, targetSize, &error);
+        if (!image.isNull()) {
+            DiskCache::Validators stored = validators;
+            stored.contentHash = DiskCache::contentHash(data);
+            DiskCache::getInstance().storePayload(source, data, stored);
+            DiskCache::getInstance().storeSnapshot(source, targetSize, image, stored);
+            ContentCache::getInstance().insert({ContentCache::Kind::Image, source, targetSize}, image);
+        }
+        QMetaObject::invokeMethod(this, [this, id, image, error]() {
+            deliver(id, image, error);
+        }, Qt::QueuedConnection);
+    }, poolPriority(id));
+}
+
+void ImageLoader::deliver(quint64 id, const QImage& image, const QString& errorString, bool stale)
+{
+    auto it = m_jobs.find(id);
+    if (it == m_jobs.end()) return;
+    const Job job = it.value();
+    m_jobs.erase(it);
+    m_jobsByKey.remove(job.key);
+
+    // Replies may have been deleted meanwhile, also by another reply's handler
+    for (const QPointer<ImageReply>& reply : job.replies) {
+        if (reply) {
+            reply->finish(image, errorString, stale);
+        }
+    }
+}
+
+void ImageLoader::forget(ImageReply* reply)
+{
+    auto it = m_jobs.find(reply->m_job);
+    if (it == m_jobs.end()) return;
+
+    Job& job = it.value();
+    job.replies.removeAll(reply);
+    job.replies.removeAll(nullptr);
+    if (job.replies.isEmpty()) {
+        // Nobody waits anymore: free the network slot and skip pending worker tasks
+        job.token.cancel();
+        Network::FetchReply* fetchReply = job.fetchReply;
+        m_jobsByKey.remove(job.key);
+        m_jobs.erase(it);
+        ++m_cancelled;
+        // Other loads may still share the transfer; it is only aborted for the last one
+        delete fetchReply;
+    } else {
+        reprioritize(it.key());
+    }
+}
+
+} // namespace Content
+} // namespace LongView
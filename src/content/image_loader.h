@@ -0,0 +1,199 @@
+#pragma once
+
+#include "cancellation_token.h"
+#include "disk_cache.h"
+#include "../network/fetch_engine.h"
+#include <QObject>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QPointer>
+#include <QSize>
+#include <QString>
+
+// Forward declarations
+class QByteArray;
+class QThreadPool;
+
+namespace LongView {
+namespace Content {
+
+/**
+ * @brief Pending result of an ImageLoader::load() call
+ *
+ * Owned by the caller; deleting it (or calling abort()) drops the result and
+ * cancels the load unless other replies still wait for it.
+ * finished() is emitted exactly once, on the GUI thread. Several replies may
+ * share one load job; each gets its own copy of the (implicitly shared) image.
+ */
+class ImageReply final : public QObject {
+    Q_OBJECT
+    Q_DISABLE_COPY(ImageReply)
+
+public:
+    ~ImageReply() override;
+
+    QString source() const { return m_source; }
+    QSize targetSize() const { return m_targetSize; }
+
+    bool isFinished() const { return m_finished; }
+    const QImage& image() const { return m_image; }
+    QString errorString() const { return m_errorString; }
+    
+    /**
+     * @brief Whether the image is the previous run's snapshot from the disk cache
+     * 
+     * Stale images are shown right away; callers should revalidate them with
+     * a CachePolicy::Refresh load.
+     */
+    bool isStale() const { return m_stale; }
+
+    /**
+     * @brief Stop waiting for the result; finished() will not be emitted
+     *
+     * The last reply of a load to be aborted cancels the load: its download
+     * is aborted and its worker tasks are skipped.
+     */
+    void abort();
+
+    /**
+     * @brief Change the urgency of the load, e.g. when its view scrolls in or out
+     */
+    void setPriority(Network::Priority priority);
+    Network::Priority priority() const { return m_priority; }
+
+signals:
+    void finished();
+
+private:
+    friend class ImageLoader;
+    ImageReply(quint64 job, const QString& source, const QSize& targetSize, Network::Priority priority,
+               QObject* parent);
+
+    void finish(const QImage& image, const QString& errorString, bool stale);
+
+    quint64 m_job;
+    QString m_source;
+    QSize m_targetSize;
+    Network::Priority m_priority;
+    QImage m_image;
+    QString m_errorString;
+    bool m_finished = false;
+    bool m_stale = false;
+};
+
+/**
+ * @brief Loads and decodes images off the GUI thread
+ *
+ * Local files (plain paths, file:// URLs and Qt resources) are read and
+ * decoded on a worker pool; http(s) URLs are downloaded through the shared
+ * Network::FetchEngine and the payload is decoded on the same pool. Decoding is done at the requested
+ * size through QImageReader::setScaledSize(), so large images never exist at
+ * full resolution in memory. Results are delivered to the GUI thread through
+ * an ImageReply.
+ *
+ * Decoded images are stored in the process-wide ContentCache, so tiles
+ * showing the same source at the same size decode it only once. Downloaded
+ * payloads and decoded snapshots are also written to the DiskCache: after a
+ * restart the last snapshot is shown immediately (as a stale result), and
+ * downloads are revalidated with conditional requests against the stored
+ * ETag / Last-Modified validators.
+ *
+ * Concurrent loads of the same source at the same size share one job: it is
+ * read, fetched and decoded once and every waiting reply gets the result. A
+ * PreferCache load may join any such job, a Refresh load only one that is
+ * itself refreshing, so a forced reload never gets a stale snapshot.
+ *
+ * Each job runs at the highest priority of its replies: downloads are queued
+ * by the FetchEngine accordingly and worker tasks are started in priority
+ * order. Changing a reply's priority re-sorts a download that is still
+ * queued; worker tasks already queued keep the priority they started with.
+ */
+class ImageLoader : public QObject {
+    Q_OBJECT
+
+public:
+    enum class CachePolicy {
+        PreferCache,  // Answer from ContentCache or a DiskCache snapshot when possible
+        Refresh       // Always load again; the result still updates the cache
+    };
+
+    // Singleton pattern
+    static ImageLoader& getInstance();
+
+    ImageLoader(const ImageLoader&) = delete;
+    ImageLoader& operator=(const ImageLoader&) = delete;
+
+    /**
+     * @brief Start loading @p source decoded to fit within @p targetSize
+     * @param source Local path, file:// / qrc: / :/ resource, or http(s) URL
+     * @param targetSize Device pixels to fit into keeping the aspect ratio;
+     *        invalid to decode at full size. Images are never upscaled.
+     * @param parent Parent of the returned reply
+     * @param policy Whether a cached image may answer the request
+     * @param priority Initial priority; see ImageReply::setPriority()
+     */
+    ImageReply* load(const QString& source, const QSize& targetSize, QObject* parent = nullptr,
+                     CachePolicy policy = CachePolicy::PreferCache,
+                     Network::Priority priority = Network::Priority::Visible);
+
+    /**
+     * @brief Decode an encoded image scaled to fit @p targetSize (thread-safe)
+     */
+    static QImage decode(const QByteArray& data, const QSize& targetSize, QString* errorString = nullptr);
+    static QImage decodeFile(const QString& path, const QSize& targetSize, QString* errorString = nullptr);
+
+    QThreadPool* threadPool() const { return m_threadPool; }
+
+    /**
+     * @brief Number of load() calls that joined a job already in flight
+     */
+    quint64 coalescedCount() const { return m_coalesced; }
+
+    /**
+     * @brief Number of jobs cancelled because every reply was aborted
+     */
+    quint64 cancelledCount() const { return m_cancelled; }
+
+private:
+    struct Job {
+        QString key;  // Empty when other loads must not join
+        QList<QPointer<ImageReply>> replies;
+        Network::Priority priority = Network::Priority::Visible;
+        QPointer<Network::FetchReply> fetchReply;
+        CancellationToken token;  // Checked by the job's worker tasks
+    };
+
+    static QString jobKey(const QString& source, const QSize& targetSize, CachePolicy policy);
+    void reprioritize(quint64 id);
+    int poolPriority(quint64 id) const;
+
+    ImageLoader();
+    ~ImageLoader() override;
+
+    void loadLocal(quint64 id, const QString& source, const QSize& targetSize, const CancellationToken& token);
+    void startDownload(quint64 id, const QString& source, const QSize& targetSize,
+                       const std::optional<DiskCache::Validators>& validators);
+    void onDownloadFinished(Network::FetchReply* fetchReply, quint64 id, const QString& source, const QSize& targetSize,
+                            const std::optional<DiskCache::Validators>& validators);
+    void decodeAsync(quint64 id, const QString& source, const QByteArray& data, const QSize& targetSize,
+                     const DiskCache::Validators& validators);
+    void deliver(quint64 id, const QImage& image, const QString& errorString, bool stale = false);
+    bool isPending(quint64 id) const { return m_jobs.contains(id); }
+    void forget(ImageReply* reply);
+    void shutdown();
+
+    friend class ImageReply;
+
+    QThreadPool* m_threadPool = nullptr;
+    // GUI thread only
+    QHash<quint64, Job> m_jobs;
+    QHash<QString, quint64> m_jobsByKey;
+    quint64 m_nextId = 0;
+    quint64 m_coalesced = 0;
+    quint64 m_cancelled = 0;
+    bool m_shuttingDown = false;
+};
+
+} // namespace Content
+} // namespace LongView
@@ -0,0 +1,179 @@
+#include "config_loader.h"
+#include "dashboard_view.h"
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QThreadPool>
+#include <QTimer>
+
+namespace LongView {
+namespace Dashboard {
+
+ConfigLoader::ConfigLoader(DashboardView* dashboard, QObject* parent)
+    : QObject(parent)
+    , m_dashboard(dashboard)
+    , m_threadPool(new QThreadPool(this))
+    , m_watcher(new QFileSystemWatcher(this))
+    , m_reloadTimer(new QTimer(this))
+{
+    // ConfigManager is not reentrant; loads must not overlap
+    m_threadPool->setMaxThreadCount(1);
+
+    m_reloadTimer->setSingleShot(true);
+    m_reloadTimer->setInterval(kReloadDelay);
+    connect(m_reloadTimer, &QTimer::timeout, this, &ConfigLoader::onWatchedPathChanged);
+    // The directory reports files that are replaced rather than written in place
+    connect(m_watcher, &QFileSystemWatcher::fileChanged, m_reloadTimer, qOverload<>(&QTimer::start));
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, m_reloadTimer, qOverload<>(&QTimer::start));
+}
+
+ConfigLoader::~ConfigLoader()
+{
+    // The worker posts back to this object; let it finish first
+    m_threadPool->waitForDone();
+}
+
+void ConfigLoader::load(const QString& filePath)
+{
+    const quint64 generation = ++m_generation;
+    m_loading = true;
+    m_failed = false;
+    m_filePath = filePath;
+    updateWatch();
+    if (m_dashboard) {
+        m_dashboard->clear();
+    }
+
+    m_threadPool->start([this, generation, path = filePath.toStdString()]() {
+        // Each part is posted on its own, so the GUI thread picks it up right away
+        Config::ParseHandler handler;
+        handler.onGroup = [this, generation](const Config::Group& group) {
+            QMetaObject::invokeMethod(this, [this, generation, group]() {
+                if (generation == m_generation && m_dashboard) {
+                    m_dashboard->addGroup(group);
+                }
+            }, Qt::QueuedConnection);
+        };
+        handler.onItem = [this, generation](const Config::Item& item) {
+            QMetaObject::invokeMethod(this, [this, generation, item]() {
+                if (generation == m_generation && m_dashboard) {
+                    m_dashboard->addItem(item);
+                }
+            }, Qt::QueuedConnection);
+        };
+
+        QString error;
+        bool fromSnapshot = false;
+        try {
+            auto& configManager = Config::ConfigManager::getInstance();
+            configManager.loadFromFile(path, handler);
+            fromSnapshot = configManager.loadedFromSnapshot();
+        } catch (const Config::ConfigException& e) {
+            error = QString::fromStdString(e.what());
+        }
+
+        QMetaObject::invokeMethod(this, [this, generation, error, fromSnapshot]() {
+            finish(generation, error, fromSnapshot);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ConfigLoader::finish(quint64 generation, const QString& error, bool fromSnapshot)
+{
+    if (generation != m_generation) return;
+    m_loading = false;
+
+    if (!error.isEmpty()) {
+        m_failed = true;
+        if (m_dashboard) {
+            m_dashboard->clear();
+        }
+        emit failed(error);
+        return;
+    }
+    emit loaded(fromSnapshot);
+}
+
+void ConfigLoader::reload()
+{
+    if (m_filePath.isEmpty()) return;
+
+    // Nothing on screen to diff against
+    if (m_failed) {
+        load(m_filePath);
+        return;
+    }
+
+    // Queued behind a load still running, so the diff is against what it delivers
+    const quint64 generation = m_generation;
+    m_threadPool->start([this, generation]() {
+        QString error;
+        Config::ConfigDiff diff;
+        Config::ConfigurationPtr config;
+        try {
+            auto& configManager = Config::ConfigManager::getInstance();
+            diff = configManager.reload();
+            config = configManager.getConfiguration();
+        } catch (const Config::ConfigException& e) {
+            error = QString::fromStdString(e.what());
+        }
+
+        QMetaObject::invokeMethod(this, [this, generation, error, diff = std::move(diff), config = std::move(config)]() {
+            finishReload(generation, error, diff, config);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ConfigLoader::finishReload(quint64 generation, const QString& error, const Config::ConfigDiff& diff,
+                                const Config::ConfigurationPtr& config)
+{
+    if (generation != m_generation) return;
+
+    // The dashboard keeps showing the last configuration that loaded
+    if (!error.isEmpty()) {
+        emit failed(error);
+        return;
+    }
+    if (diff.isEmpty()) return;
+
+    if (m_dashboard) {
+        m_dashboard->applyConfiguration(*config, diff);
+    }
+    emit reloaded();
+}
+
+void ConfigLoader::setWatchEnabled(bool enabled)
+{
+    if (m_watchEnabled == enabled) return;
+    m_watchEnabled = enabled;
+    updateWatch();
+}
+
+void ConfigLoader::updateWatch()
+{
+    m_reloadTimer->stop();
+    const QStringList watched = m_watcher->files() + m_watcher->directories();
+    if (!watched.isEmpty()) {
+        m_watcher->removePaths(watched);
+    }
+    if (!m_watchEnabled || m_filePath.isEmpty()) return;
+
+    const QFileInfo info(m_filePath);
+    m_watcher->addPath(info.absolutePath());
+    if (info.exists()) {
+        m_watcher->addPath(info.absoluteFilePath());
+    }
+}
+
+void ConfigLoader::onWatchedPathChanged()
+{
+    // Replacing the file drops it from the watcher; follow the new one
+    const QFileInfo info(m_filePath);
+    if (!info.exists()) return;
+    if (!m_watcher->files().contains(info.absoluteFilePath())) {
+        m_watcher->addPath(info.absoluteFilePath());
+    }
+    reload();
+}
+
+} // namespace Dashboard
+} // namespace LongView
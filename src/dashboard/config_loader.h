@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../config/config_manager.h"
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+// Forward declarations
+class QFileSystemWatcher;
+class QThreadPool;
+class QTimer;
+
+namespace LongView {
+namespace Dashboard {
+
+class DashboardView;
+
+/**
+ * @brief Loads a configuration file in the background and fills a dashboard as it is parsed
+ *
+ * The file is parsed on a worker thread through the streaming load of
+ * Config::ConfigManager. Every group and top-level item is posted to the GUI
+ * thread as soon as the parser completes it, so the first tiles are laid out
+ * and shown while the rest of a large file is still being parsed. A current
+ * compiled snapshot is replayed the same way.
+ *
+ * Loads run one at a time in request order; starting a new load discards
+ * whatever the previous one still delivers. A failed load clears the
+ * dashboard, so a broken file never leaves a half-built dashboard behind.
+ *
+ * The loaded file is watched. When it changes, it is parsed again in the
+ * background and only the difference to the configuration on screen is
+ * applied (see DashboardView::applyConfiguration()), so editing one line of
+ * a large file does not rebuild the dashboard. A reload that fails keeps the
+ * dashboard as it was; after a failed load the next change loads the file
+ * from scratch.
+ */
+class ConfigLoader : public QObject {
+    Q_OBJECT
+    Q_DISABLE_COPY(ConfigLoader)
+
+public:
+    explicit ConfigLoader(DashboardView* dashboard, QObject* parent = nullptr);
+    ~ConfigLoader() override;
+
+    /**
+     * @brief Clear the dashboard and start loading @p filePath
+     */
+    void load(const QString& filePath);
+
+    bool isLoading() const { return m_loading; }
+
+    /**
+     * @brief Re-read the loaded file and apply what changed
+     */
+    void reload();
+
+    /**
+     * @brief Reload automatically when the loaded file changes (default on)
+     */
+    void setWatchEnabled(bool enabled);
+    bool isWatchEnabled() const { return m_watchEnabled; }
+
+signals:
+    /**
+     * @brief All groups and items of the file have been added
+     * @param fromSnapshot Whether a compiled snapshot answered instead of the parser
+     */
+    void loaded(bool fromSnapshot);
+    void failed(const QString& message);
+
+    /**
+     * @brief A changed file has been applied to the dashboard
+     */
+    void reloaded();
+
+private:
+    // Editors save in bursts (truncate, write, rename); wait for the file to settle
+    static constexpr int kReloadDelay = 300;  // ms
+
+    void finish(quint64 generation, const QString& error, bool fromSnapshot);
+    void finishReload(quint64 generation, const QString& error, const Config::ConfigDiff& diff,
+                      const Config::ConfigurationPtr& config);
+    void updateWatch();
+    void onWatchedPathChanged();
+
+    QPointer<DashboardView> m_dashboard;
+    QThreadPool* m_threadPool = nullptr;
+    QFileSystemWatcher* m_watcher = nullptr;
+    QTimer* m_reloadTimer = nullptr;
+    QString m_filePath;
+    quint64 m_generation = 0;  // GUI thread only
+    bool m_loading = false;
+    bool m_failed = false;
+    bool m_watchEnabled = true;
+};
+
+} // namespace Dashboard
+} // namespace LongView
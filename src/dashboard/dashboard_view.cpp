@@ -0,0 +1,573 @@
+#include "dashboard_view.h"
+#include "../tiles/base/tile.h"
+#include "../tiles/item/item_tile.h"
+#include "../tiles/group/group_tile.h"
+#include "../tiles/group/virtual_item_list.h"
+#include "../refresh/refresh_scheduler.h"
+#include <QEvent>
+#include <QResizeEvent>
+#include <QScrollBar>
+#include <QTimer>
+#include <algorithm>
+#include <chrono>
+
+namespace LongView {
+namespace Dashboard {
+
+DashboardView::DashboardView(QWidget* parent)
+    : QAbstractScrollArea(parent)
+    , m_refreshScheduler(new Refresh::RefreshScheduler(this))
+{
+    setFrameShape(QFrame::NoFrame);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    verticalScrollBar()->setSingleStep(kScrollStep);
+}
+
+DashboardView::~DashboardView()
+{
+    // Tiles live on the viewport; delete them while our bookkeeping still exists
+    clear();
+}
+
+void DashboardView::setConfiguration(const Config::Configuration& config)
+{
+    clear();
+
+    if (config.groups) {
+        for (const auto& group : *config.groups) {
+            addGroup(group);
+        }
+    }
+    if (config.items) {
+        for (const auto& item : *config.items) {
+            addItem(item);
+        }
+    }
+}
+
+void DashboardView::applyConfiguration(const Config::Configuration& config, const Config::ConfigDiff& diff)
+{
+    static const std::vector<Config::Group> noGroups;
+    static const std::vector<Config::Item> noItems;
+    const auto& groups = config.groups ? *config.groups : noGroups;
+    const auto& items = config.items ? *config.items : noItems;
+
+    // Tiles mirror the old configuration: its groups first, then its items
+    const size_t groupCount = static_cast<size_t>(
+        std::partition_point(m_entries.begin(), m_entries.end(), [](const Entry& entry) {
+            return entry.tile->kind() == Tiles::Tile::Kind::Group;
+        }) - m_entries.begin());
+    const size_t keptGroups = groups.size() - diff.groups.added.size();
+    const size_t keptItems = items.size() - diff.items.added.size();
+    if (groupCount != keptGroups + diff.groups.removed.size() ||
+        m_entries.size() - groupCount != keptItems + diff.items.removed.size()) {
+        setConfiguration(config);
+        return;
+    }
+
+    std::vector<Entry> entries;
+    entries.reserve(groups.size() + items.size());
+    std::vector<Tiles::Tile*> created;
+    std::vector<Tiles::Tile*> obsolete;
+
+    for (size_t i = 0; i < groups.size(); ++i) {
+        const int source = diff.groups.sources[i];
+        if (source >= 0 && !diff.groups.isModified(static_cast<int>(i))) {
+            const Entry& entry = m_entries[static_cast<size_t>(source)];
+            static_cast<Tiles::GroupTile*>(entry.tile)->applyConfig(groups[i], diff.groupItems[i]);
+            entries.push_back(entry);
+            continue;
+        }
+        // A changed max_height changes how the group is built (nested scroll area or not)
+        if (source >= 0) {
+            obsolete.push_back(m_entries[static_cast<size_t>(source)].tile);
+        }
+        Entry entry;
+        entry.tile = new Tiles::GroupTile(groups[i], viewport());
+        created.push_back(entry.tile);
+        entries.push_back(entry);
+    }
+    for (int index : diff.groups.removed) {
+        obsolete.push_back(m_entries[static_cast<size_t>(index)].tile);
+    }
+
+    for (size_t i = 0; i < items.size(); ++i) {
+        const int source = diff.items.sources[i];
+        if (source < 0) {
+            Entry entry;
+            entry.tile = new Tiles::ItemTile(items[i], viewport());
+            created.push_back(entry.tile);
+            entries.push_back(entry);
+            continue;
+        }
+        Entry entry = m_entries[groupCount + static_cast<size_t>(source)];
+        if (diff.items.isModified(static_cast<int>(i))) {
+            auto* itemTile = static_cast<Tiles::ItemTile*>(entry.tile);
+            itemTile->bind(items[i]);
+            scheduleItemRefresh(itemTile);
+            entry.dirty = true;
+        }
+        entries.push_back(entry);
+    }
+    for (int index : diff.items.removed) {
+        obsolete.push_back(m_entries[groupCount + static_cast<size_t>(index)].tile);
+    }
+
+    for (auto* tile : obsolete) {
+        deleteTile(tile);
+    }
+
+    m_entries = std::move(entries);
+    m_indices.clear();
+    rebuildIndex(0);
+
+    // Restack with the heights known so far; only new and rebound tiles are measured again
+    int y = kMargin;
+    m_firstDirty = SIZE_MAX;
+    m_firstVisible = -1;
+    m_lastVisible = -1;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        Entry& entry = m_entries[i];
+        entry.top = y;
+        y += entry.height + kSpacing;
+        if (entry.dirty) {
+            m_firstDirty = std::min(m_firstDirty, i);
+        }
+        // The shown range must cover every tile still shown, so the next pass hides those that left it
+        if (!entry.tile->isHidden()) {
+            if (m_firstVisible < 0) m_firstVisible = static_cast<int>(i);
+            m_lastVisible = static_cast<int>(i);
+        }
+    }
+
+    for (auto* tile : created) {
+        adoptTile(tile);
+    }
+    scheduleLayout();
+}
+
+Tiles::GroupTile* DashboardView::addGroup(const Config::Group& group)
+{
+    // Groups stay above the top-level items, whatever order they arrive in
+    const auto firstItem = std::partition_point(m_entries.begin(), m_entries.end(), [](const Entry& entry) {
+        return entry.tile->kind() == Tiles::Tile::Kind::Group;
+    });
+    auto* tile = new Tiles::GroupTile(group, viewport());
+    insertTile(static_cast<size_t>(firstItem - m_entries.begin()), tile);
+    return tile;
+}
+
+Tiles::ItemTile* DashboardView::addItem(const Config::Item& item)
+{
+    auto* tile = new Tiles::ItemTile(item, viewport());
+    insertTile(m_entries.size(), tile);
+    return tile;
+}
+
+void DashboardView::clear()
+{
+    std::vector<Entry> entries;
+    entries.swap(m_entries);
+    m_indices.clear();
+    m_firstDirty = SIZE_MAX;
+    m_firstVisible = -1;
+    m_lastVisible = -1;
+    m_refreshScheduler->clear();
+
+    for (const Entry& entry : entries) {
+        deleteTile(entry.tile);
+    }
+
+    updateScrollBar();
+    if (!entries.empty()) {
+        emit visibleRangeChanged(-1, -1);
+    }
+}
+
+int DashboardView::indexOfTile(const Tiles::Tile* tile) const
+{
+    auto it = m_indices.find(tile);
+    return it != m_indices.end() ? static_cast<int>(it->second) : -1;
+}
+
+int DashboardView::contentHeight() const
+{
+    if (m_entries.empty()) return 0;
+    const Entry& last = m_entries.back();
+    return last.top + last.height + kMargin;
+}
+
+void DashboardView::ensureTileVisible(const Tiles::Tile* tile)
+{
+    const int index = indexOfTile(tile);
+    if (index < 0) return;
+
+    if (m_firstDirty != SIZE_MAX) {
+        layoutEntries();
+    }
+
+    const Entry& entry = m_entries[index];
+    auto* bar = verticalScrollBar();
+    const int viewportHeight = viewport()->height();
+    if (entry.top < bar->value()) {
+        bar->setValue(entry.top - kMargin);
+    } else if (entry.top + entry.height > bar->value() + viewportHeight) {
+        // Prefer showing the whole tile, but never scroll its top out of view
+        bar->setValue(std::min(entry.top - kMargin, entry.top + entry.height + kMargin - viewportHeight));
+    }
+}
+
+bool DashboardView::eventFilter(QObject* watched, QEvent* event)
+{
+    // A tile's layout changed (content created, expanded, collapsed, ...)
+    if (event->type() == QEvent::LayoutRequest) {
+        auto it = m_indices.find(static_cast<const Tiles::Tile*>(watched));
+        if (it != m_indices.end()) {
+            markDirty(it->second);
+        }
+    }
+    return QAbstractScrollArea::eventFilter(watched, event);
+}
+
+void DashboardView::resizeEvent(QResizeEvent* event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    // Re-measures everything if the width changed, otherwise just refreshes the view
+    layoutEntries();
+}
+
+void DashboardView::scrollContentsBy(int dx, int dy)
+{
+    Q_UNUSED(dx);
+    Q_UNUSED(dy);
+    // Tiles are positioned by hand; don't let the viewport scroll them as pixels
+    if (!m_inLayout) {
+        updateVisibleTiles();
+    }
+}
+
+void DashboardView::insertTile(size_t index, Tiles::Tile* tile)
+{
+    Entry entry;
+    entry.tile = tile;
+    if (index > 0) {
+        const Entry& previous = m_entries[index - 1];
+        entry.top = previous.top + previous.height + kSpacing;
+    } else {
+        entry.top = kMargin;
+    }
+    m_entries.insert(m_entries.begin() + static_cast<std::ptrdiff_t>(index), entry);
+    rebuildIndex(index);
+
+    // Keep the shown range pointing at the same tiles
+    const int inserted = static_cast<int>(index);
+    if (inserted <= m_firstVisible) ++m_firstVisible;
+    if (inserted <= m_lastVisible) ++m_lastVisible;
+
+    markDirty(index);
+    adoptTile(tile);
+}
+
+void DashboardView::adoptTile(Tiles::Tile* tile)
+{
+    // Off-screen until the next layout pass decides otherwise
+    tile->hide();
+    tile->installEventFilter(this);
+    connect(tile, &QObject::destroyed, this, [this, tile]() {
+        removeTile(tile);
+    });
+    trackRefresh(tile);
+}
+
+void DashboardView::removeTile(Tiles::Tile* tile)
+{
+    auto it = m_indices.find(tile);
+    if (it == m_indices.end()) return;
+
+    const size_t index = it->second;
+    m_indices.erase(it);
+    m_entries.erase(m_entries.begin() + static_cast<std::ptrdiff_t>(index));
+    rebuildIndex(index);
+
+    // Keep the shown range pointing at the same tiles
+    const int removed = static_cast<int>(index);
+    if (removed <= m_lastVisible) --m_lastVisible;
+    if (removed < m_firstVisible) --m_firstVisible;
+    if (m_firstDirty != SIZE_MAX && m_firstDirty > index) --m_firstDirty;
+
+    if (index < m_entries.size()) {
+        markDirty(index);
+    } else {
+        updateScrollBar();
+        updateVisibleTiles();
+    }
+}
+
+void DashboardView::deleteTile(Tiles::Tile* tile)
+{
+    // Already out of the entries; must not call back into removeTile()
+    tile->removeEventFilter(this);
+    disconnect(tile, nullptr, this, nullptr);
+    delete tile;
+}
+
+void DashboardView::rebuildIndex(size_t from)
+{
+    for (size_t i = from; i < m_entries.size(); ++i) {
+        m_indices[m_entries[i].tile] = i;
+    }
+}
+
+void DashboardView::trackRefresh(Tiles::Tile* tile)
+{
+    if (tile->kind() == Tiles::Tile::Kind::Item) {
+        scheduleItemRefresh(static_cast<Tiles::ItemTile*>(tile));
+        return;
+    }
+
+    // Groups are not refreshed themselves; their item tiles are, as they come and go
+    auto* group = static_cast<Tiles::GroupTile*>(tile);
+    connect(group, &Tiles::GroupTile::itemTileAttached, this, &DashboardView::scheduleItemRefresh);
+    connect(group, &Tiles::GroupTile::itemTileDetached, this,
+            [this](Tiles::ItemTile* itemTile) { m_refreshScheduler->unschedule(itemTile); });
+    // Batched expand/collapse and completion skip the items' own signals
+    connect(group, &Tiles::GroupTile::itemsExpandedChanged, this,
+            [this, group]() { updateItemTileStates(group); });
+    connect(group, &Tiles::GroupTile::itemsCompletedChanged, this,
+            [this, group]() { updateItemTileStates(group); });
+    for (auto* itemTile : group->itemTiles()) {
+        scheduleItemRefresh(itemTile);
+    }
+    if (auto* virtualList = group->virtualItemList()) {
+        for (const auto& [row, itemTile] : virtualList->liveTiles()) {
+            scheduleItemRefresh(itemTile);
+        }
+    }
+}
+
+void DashboardView::scheduleItemRefresh(Tiles::ItemTile* itemTile)
+{
+    // Also reschedules recycled tiles that were rebound to another item
+    const auto& frequency = itemTile->item().refresh_frequency;
+    if (frequency && *frequency > 0) {
+        // Items showing the same source refresh together and share one load
+        m_refreshScheduler->schedule(itemTile, std::chrono::seconds(*frequency),
+                                     QString::fromStdString(itemTile->item().value));
+    } else {
+        m_refreshScheduler->unschedule(itemTile);
+    }
+}
+
+void DashboardView::updateItemTileStates(Tiles::GroupTile* group)
+{
+    for (auto* itemTile : group->itemTiles()) {
+        m_refreshScheduler->updateTileState(itemTile);
+    }
+    if (auto* virtualList = group->virtualItemList()) {
+        for (const auto& [row, itemTile] : virtualList->liveTiles()) {
+            m_refreshScheduler->updateTileState(itemTile);
+        }
+    }
+}
+
+void DashboardView::markDirty(size_t index)
+{
+    m_entries[index].dirty = true;
+    m_firstDirty = std::min(m_firstDirty, index);
+    scheduleLayout();
+}
+
+void DashboardView::scheduleLayout()
+{
+    // Coalesce all layout requests of one event loop pass into one layout
+    if (m_layoutPending) return;
+    m_layoutPending = true;
+    QTimer::singleShot(0, this, &DashboardView::layoutEntries);
+}
+
+void DashboardView::layoutEntries()
+{
+    m_layoutPending = false;
+
+    const int width = contentWidth();
+    if (width != m_lastWidth) {
+        m_lastWidth = width;
+        for (Entry& entry : m_entries) {
+            entry.dirty = true;
+        }
+        if (!m_entries.empty()) {
+            m_firstDirty = 0;
+        }
+    }
+
+    if (m_firstDirty >= m_entries.size()) {
+        m_firstDirty = SIZE_MAX;
+        updateScrollBar();
+        updateVisibleTiles();
+        return;
+    }
+
+    m_inLayout = true;
+
+    // Keep the tile at the top of the viewport where it is while heights change
+    auto* bar = verticalScrollBar();
+    int anchor = -1;
+    int anchorOffset = 0;
+    if (bar->value() > 0) {
+        anchor = entryAt(bar->value());
+        anchorOffset = bar->value() - m_entries[anchor].top;
+    }
+
+    // Only tiles from the first dirty one downwards can move
+    int y = kMargin;
+    if (m_firstDirty > 0) {
+        const Entry& previous = m_entries[m_firstDirty - 1];
+        y = previous.top + previous.height + kSpacing;
+    }
+    for (size_t i = m_firstDirty; i < m_entries.size(); ++i) {
+        Entry& entry = m_entries[i];
+        if (entry.dirty) {
+            entry.height = measure(entry.tile, width);
+            entry.dirty = false;
+        }
+        entry.top = y;
+        y += entry.height + kSpacing;
+    }
+    m_firstDirty = SIZE_MAX;
+
+    updateScrollBar();
+    if (anchor >= 0) {
+        bar->setValue(m_entries[anchor].top + anchorOffset);
+    }
+    updateVisibleTiles();
+
+    m_inLayout = false;
+}
+
+int DashboardView::measure(Tiles::Tile* tile, int width) const
+{
+    int height = tile->hasHeightForWidth() ? tile->heightForWidth(width) : -1;
+    if (height < 0) {
+        height = tile->sizeHint().height();
+    }
+    height = std::max(height, tile->minimumSizeHint().height());
+    return std::clamp(height, tile->minimumHeight(), tile->maximumHeight());
+}
+
+int DashboardView::contentWidth() const
+{
+    return std::max(0, viewport()->width() - 2 * kMargin);
+}
+
+int DashboardView::entryAt(int y) const
+{
+    // Last entry starting at or above y
+    auto it = std::upper_bound(m_entries.begin(), m_entries.end(), y,
+                               [](int value, const Entry& entry) { return value < entry.top; });
+    if (it == m_entries.begin()) return 0;
+    return static_cast<int>(std::distance(m_entries.begin(), it)) - 1;
+}
+
+void DashboardView::updateScrollBar()
+{
+    auto* bar = verticalScrollBar();
+    const int viewportHeight = viewport()->height();
+    bar->setPageStep(viewportHeight);
+    bar->setRange(0, std::max(0, contentHeight() - viewportHeight));
+}
+
+void DashboardView::updateVisibleTiles()
+{
+    int first = -1;
+    int last = -1;
+    const int scrollY = verticalScrollBar()->value();
+    if (!m_entries.empty() && viewport()->height() > 0) {
+        first = entryAt(std::max(0, scrollY - kOverscan));
+        last = entryAt(scrollY + viewport()->height() - 1 + kOverscan);
+    }
+
+    // Hide tiles that left the viewport and its margin
+    if (m_firstVisible >= 0) {
+        const int end = std::min(m_lastVisible, static_cast<int>(m_entries.size()) - 1);
+        for (int i = m_firstVisible; i <= end; ++i) {
+            if (i < first || i > last) {
+                m_entries[i].tile->hide();
+            }
+        }
+    }
+
+    // Position and show the tiles inside them; tiles in the margin are clipped
+    const int width = contentWidth();
+    for (int i = first; i >= 0 && i <= last; ++i) {
+        const Entry& entry = m_entries[i];
+        entry.tile->setGeometry(kMargin, entry.top - scrollY, width, entry.height);
+        if (entry.tile->isHidden()) {
+            entry.tile->show();
+        }
+        if (entry.tile->kind() == Tiles::Tile::Kind::Group) {
+            static_cast<Tiles::GroupTile*>(entry.tile)->updateVisibleRegion(viewport());
+        }
+    }
+
+    // Only tiles in the old or new range can have scrolled in or out of
+    // view; re-check those rather than every scheduled tile
+    const int count = static_cast<int>(m_entries.size());
+    auto updateStates = [this, count](int from, int to) {
+        for (int i = std::max(from, 0); i <= std::min(to, count - 1); ++i) {
+            Tiles::Tile* tile = m_entries[i].tile;
+            if (tile->kind() == Tiles::Tile::Kind::Item) {
+                m_refreshScheduler->updateTileState(tile);
+            } else {
+                updateItemTileStates(static_cast<Tiles::GroupTile*>(tile));
+            }
+        }
+    };
+    updateStates(first, last);
+    if (m_firstVisible >= 0) {
+        updateStates(m_firstVisible, std::min(m_lastVisible, first - 1));
+        updateStates(std::max(m_firstVisible, last + 1), m_lastVisible);
+    }
+    scheduleLoadPriorityUpdate();
+
+    if (first != m_firstVisible || last != m_lastVisible) {
+        m_firstVisible = first;
+        m_lastVisible = last;
+        emit visibleRangeChanged(first, last);
+    }
+}
+
+void DashboardView::scheduleLoadPriorityUpdate()
+{
+    // Once per event loop pass, after virtualized groups placed their tiles
+    if (m_priorityUpdatePending) return;
+    m_priorityUpdatePending = true;
+    QTimer::singleShot(0, this, &DashboardView::updateLoadPriorities);
+}
+
+void DashboardView::updateLoadPriorities()
+{
+    m_priorityUpdatePending = false;
+
+    // Hidden tiles were demoted by their hide events; re-rank the shown ones
+    const int end = std::min(m_lastVisible, static_cast<int>(m_entries.size()) - 1);
+    for (int i = m_firstVisible; i >= 0 && i <= end; ++i) {
+        Tiles::Tile* tile = m_entries[i].tile;
+        if (tile->kind() == Tiles::Tile::Kind::Item) {
+            static_cast<Tiles::ItemTile*>(tile)->updateLoadPriority();
+            continue;
+        }
+        auto* group = static_cast<Tiles::GroupTile*>(tile);
+        for (auto* itemTile : group->itemTiles()) {
+            itemTile->updateLoadPriority();
+        }
+        if (auto* virtualList = group->virtualItemList()) {
+            for (const auto& [row, itemTile] : virtualList->liveTiles()) {
+                itemTile->updateLoadPriority();
+            }
+        }
+    }
+}
+
+} // namespace Dashboard
+} // namespace LongView
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "../config/config.h"
+#include "../config/config_diff.h"
+#include <QAbstractScrollArea>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations
+class QEvent;
+
+namespace LongView {
+
+namespace Tiles {
+class Tile;
+class ItemTile;
+class GroupTile;
+}
+
+namespace Refresh {
+class RefreshScheduler;
+}
+
+namespace Dashboard {
+
+/**
+ * @brief Single scroll surface hosting all top-level tiles of a dashboard
+ *
+ * Tiles are stacked vertically on the viewport and positioned by hand, so the
+ * whole dashboard scrolls with one scrollbar instead of one scroll area per
+ * group. Only tiles intersecting the viewport or an overscan margin around it
+ * are shown; the rest stay hidden and keep their last measured height. Tiles
+ * in the margin start loading their content early, at a lower priority than
+ * the tiles on screen, and are re-ranked as the view scrolls. When a tile's
+ * layout changes, only the tiles from that position downwards are re-measured
+ * and moved, and the scroll position stays anchored to the tile at the top of
+ * the viewport.
+ *
+ * Virtualized groups are told which part of them is on screen. Groups with a
+ * configured max_height keep their own nested scroll area.
+ *
+ * The view owns the RefreshScheduler that refreshes every item tile with a
+ * configured refresh_frequency, including tiles inside groups. Scrolling
+ * makes the scheduler re-check which tiles are on screen, so hidden tiles
+ * are throttled.
+ */
+class DashboardView final : public QAbstractScrollArea {
+    Q_OBJECT
+    Q_DISABLE_COPY(DashboardView)
+
+public:
+    static constexpr int kMargin = 12;
+    static constexpr int kSpacing = 12;
+    static constexpr int kScrollStep = 24;
+    static constexpr int kOverscan = 480;  // pixels above and below the viewport
+
+    explicit DashboardView(QWidget* parent = nullptr);
+    ~DashboardView() override;
+
+    /**
+     * @brief Replace all tiles with the groups and items of a configuration
+     */
+    void setConfiguration(const Config::Configuration& config);
+
+    /**
+     * @brief Change the tiles from the current configuration to an edited one
+     *
+     * Only what @p diff names is rebuilt: tiles of removed groups and items are
+     * deleted, added ones created, moved ones reordered and modified items
+     * rebound. All other tiles, down to the items inside groups, keep their
+     * expanded/completed state, their content and loads in flight, and their
+     * measured height. A group whose max_height changed is rebuilt as a whole.
+     *
+     * @param config The edited configuration
+     * @param diff Difference from the configuration currently shown to @p config
+     */
+    void applyConfiguration(const Config::Configuration& config, const Config::ConfigDiff& diff);
+
+    /**
+     * @brief Add a tile for a group or a top-level item
+     *
+     * Groups are kept above all top-level items, as in setConfiguration(), so
+     * a configuration can be added piece by piece while it is being parsed.
+     */
+    Tiles::GroupTile* addGroup(const Config::Group& group);
+    Tiles::ItemTile* addItem(const Config::Item& item);
+    void clear();
+
+    int tileCount() const { return static_cast<int>(m_entries.size()); }
+    Tiles::Tile* tileAt(int index) const { return m_entries[index].tile; }
+    int indexOfTile(const Tiles::Tile* tile) const;
+
+    /**
+     * @brief Height of all stacked tiles including margins
+     */
+    int contentHeight() const;
+
+    /**
+     * @brief Scroll so that the given tile's top edge is visible
+     */
+    void ensureTileVisible(const Tiles::Tile* tile);
+
+    Refresh::RefreshScheduler* refreshScheduler() const { return m_refreshScheduler; }
+
+signals:
+    /**
+     * @brief Emitted when the range of shown tiles (including overscan) changes
+     * @param first Index of the first shown tile, or -1 if none
+     * @param last Index of the last shown tile, or -1 if none
+     */
+    void visibleRangeChanged(int first, int last);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void scrollContentsBy(int dx, int dy) override;
+
+private:
+    struct Entry {
+        Tiles::Tile* tile = nullptr;
+        int top = 0;
+        int height = 0;
+        bool dirty = true;  // needs re-measuring
+    };
+
+    void insertTile(size_t index, Tiles::Tile* tile);
+    void adoptTile(Tiles::Tile* tile);
+    void removeTile(Tiles::Tile* tile);
+    void deleteTile(Tiles::Tile* tile);
+    void rebuildIndex(size_t from);
+    void trackRefresh(Tiles::Tile* tile);
+    void scheduleItemRefresh(Tiles::ItemTile* itemTile);
+    void updateItemTileStates(Tiles::GroupTile* group);
+
+    void markDirty(size_t index);
+    void scheduleLayout();
+    void layoutEntries();
+    int measure(Tiles::Tile* tile, int width) const;
+    int contentWidth() const;
+    int entryAt(int y) const;
+
+    void updateScrollBar();
+    void updateVisibleTiles();
+    void scheduleLoadPriorityUpdate();
+    void updateLoadPriorities();
+
+    std::vector<Entry> m_entries;
+    std::unordered_map<const Tiles::Tile*, size_t> m_indices;
+    Refresh::RefreshScheduler* m_refreshScheduler = nullptr;
+
+    size_t m_firstDirty = SIZE_MAX;  // SIZE_MAX when nothing is dirty
+    int m_lastWidth = -1;
+    int m_firstVisible = -1;
+    int m_lastVisible = -1;
+    bool m_layoutPending = false;
+    bool m_priorityUpdatePending = false;
+    bool m_inLayout = false;
+};
+
+} // namespace Dashboard
+} // namespace LongView
@@ -1,8 +1,18 @@
 #include <QApplication>
 #include <QMainWindow>
 #include <QScreen>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QStandardPaths>
 #include "windowutils.h"
 #include "appintegration.h"
+#include "theme/theme_manager.h"
+#include "config/config_manager.h"
+#include "dashboard/dashboard_view.h"
+#include "dashboard/config_loader.h"
+#ifdef LONGVIEW_WEBENGINE
+#include "views/web_page_pool.h"
+#endif
 
 // Application settings
 const QString APP_TITLE = "Long View";
@@ -14,6 +24,10 @@ const int WINDOW_HEIGHT = 768;
 
 int main(int argc, char *argv[])
 {
+#ifdef LONGVIEW_WEBENGINE
+    // Must happen before the application object exists
+    LongView::Views::WebPagePool::configureEngine();
+#endif
     QApplication app(argc, argv);
     
     // Set application information
@@ -25,11 +39,47 @@ int main(int argc, char *argv[])
     // Load application icon
     AppIntegration::loadApplicationIcon(app);
     
+    // Apply tile theme once for the whole application
+    LongView::Theme::ThemeManager::getInstance().ensureApplied();
+    
+    // Parse command line
+    QCommandLineParser parser;
+    parser.setApplicationDescription(APP_TITLE);
+    parser.addHelpOption();
+    parser.addPositionalArgument("config", QCoreApplication::translate("main", "Dashboard configuration file (YAML)."));
+    parser.process(app);
+    
     // Create main window
     QMainWindow mainWindow;
     mainWindow.setWindowTitle(APP_TITLE);
     mainWindow.resize(WINDOW_WIDTH, WINDOW_HEIGHT);
     
+    // All tiles share one scroll surface
+    auto* dashboard = new LongView::Dashboard::DashboardView(&mainWindow);
+    mainWindow.setCentralWidget(dashboard);
+    
+    // Load configuration
+    const QStringList arguments = parser.positionalArguments();
+    if (!arguments.isEmpty()) {
+        auto& configManager = LongView::Config::ConfigManager::getInstance();
+        // Compiled snapshots skip YAML parsing on later starts; LONGVIEW_CONFIG_SNAPSHOTS=0 disables them
+        bool ok = false;
+        const int snapshots = qEnvironmentVariableIntValue("LONGVIEW_CONFIG_SNAPSHOTS", &ok);
+        if (!ok || snapshots != 0) {
+            const QString directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/config";
+            configManager.setSnapshotDirectory(directory.toStdString());
+        }
+        // Parsed in the background; tiles appear group by group
+        auto* configLoader = new LongView::Dashboard::ConfigLoader(dashboard, &mainWindow);
+        QObject::connect(configLoader, &LongView::Dashboard::ConfigLoader::failed, [](const QString& message) {
+            qWarning() << "Failed to load configuration:" << message;
+        });
+        // Edits of the file are applied live; LONGVIEW_CONFIG_WATCH=0 disables that
+        const int watch = qEnvironmentVariableIntValue("LONGVIEW_CONFIG_WATCH", &ok);
+        configLoader->setWatchEnabled(!ok || watch != 0);
+        configLoader->load(arguments.first());
+    }
+    
     // Center and show window
     WindowUtils::centerWindowOnScreen(&mainWindow);
     
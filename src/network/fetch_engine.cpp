@@ -0,0 +1,340 @@
+#include "fetch_engine.h"
+
+#include <QCoreApplication>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <algorithm>
+
+namespace LongView {
+namespace Network {
+
+namespace {
+    // The raw Content-Length is the encoded size of a compressed body;
+    // chunked responses fall back to what downloadProgress() reported
+    qint64 wireBodySize(const QNetworkReply* reply, qint64 bytesReceived)
+    {
+        bool ok = false;
+        const qint64 contentLength = reply->rawHeader("Content-Length").toLongLong(&ok);
+        return ok ? contentLength : bytesReceived;
+    }
+
+    QNetworkRequest::Priority requestPriority(Priority priority)
+    {
+        switch (priority) {
+        case Priority::Visible:
+            return QNetworkRequest::HighPriority;
+        case Priority::Overscan:
+            return QNetworkRequest::NormalPriority;
+        case Priority::Offscreen:
+        case Priority::Prefetch:
+            break;
+        }
+        return QNetworkRequest::LowPriority;
+    }
+}
+
+FetchReply::FetchReply(FetchEngine* engine, const QUrl& url, Priority priority, QObject* parent)
+    : QObject(parent)
+    , m_engine(engine)
+    , m_url(url)
+    , m_priority(priority)
+{
+}
+
+FetchReply::~FetchReply()
+{
+    abort();
+}
+
+void FetchReply::abort()
+{
+    if (m_finished) return;
+    m_finished = true;
+    if (m_engine) {
+        m_engine->detach(this);
+    }
+}
+
+void FetchReply::setPriority(Priority priority)
+{
+    if (priority == m_priority) return;
+    m_priority = priority;
+    if (!m_finished && m_engine) {
+        m_engine->reprioritize(m_transfer);
+    }
+}
+
+FetchEngine& FetchEngine::getInstance()
+{
+    static FetchEngine instance;
+    return instance;
+}
+
+FetchEngine::FetchEngine(QObject* parent)
+    : QObject(parent)
+    , m_network(new QNetworkAccessManager(this))
+{
+    m_network->setRedirectPolicy(QNetworkRequest::NoLessSafeRedirectPolicy);
+    m_network->setTransferTimeout(m_transferTimeout);
+
+    // The manager and its replies must be gone before the application object
+    if (auto* app = QCoreApplication::instance()) {
+        connect(app, &QCoreApplication::aboutToQuit, this, &FetchEngine::shutdown);
+    }
+}
+
+FetchEngine::~FetchEngine() = default;
+
+FetchReply* FetchEngine::fetch(const QUrl& url, const Validators& validators, QObject* parent, Priority priority)
+{
+    auto* reply = new FetchReply(this, url, priority, parent);
+
+    // Join an identical transfer that is already in flight or queued
+    const QString key = transferKey(url, validators);
+    auto existing = m_transfersByKey.constFind(key);
+    if (existing != m_transfersByKey.constEnd()) {
+        reply->m_transfer = existing.value();
+        m_transfers[existing.value()].subscribers.append(reply);
+        ++m_statistics.coalesced;
+        reprioritize(existing.value());
+        return reply;
+    }
+
+    QNetworkRequest request(url);
+    // Keep-alive is the default; allow multiplexing over one HTTP/2 connection
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    request.setHeader(QNetworkRequest::UserAgentHeader,
+                      QCoreApplication::applicationName() + '/' + QCoreApplication::applicationVersion());
+    // Accept-Encoding is deliberately left to Qt, which then decompresses for us
+
+    if (!validators.etag.isEmpty()) {
+        request.setRawHeader("If-None-Match", validators.etag);
+    }
+    if (!validators.lastModified.isEmpty()) {
+        request.setRawHeader("If-Modified-Since", validators.lastModified);
+    }
+
+    const quint64 transferId = ++m_nextTransferId;
+    Transfer& transfer = m_transfers[transferId];
+    transfer.key = key;
+    transfer.host = url.host();
+    transfer.request = request;
+    transfer.priority = priority;
+    transfer.subscribers.append(reply);
+    m_transfersByKey.insert(key, transferId);
+    reply->m_transfer = transferId;
+
+    m_queue.insert({priority, transferId});
+    startQueued();
+    if (!transfer.networkReply) {
+        ++m_statistics.queued;
+    }
+    return reply;
+}
+
+void FetchEngine::setTransferTimeout(int msec)
+{
+    m_transferTimeout = msec;
+    if (m_network) {
+        m_network->setTransferTimeout(msec);
+    }
+}
+
+void FetchEngine::setMaxTransfers(int count)
+{
+    m_maxTransfers = std::max(1, count);
+    startQueued();
+}
+
+void FetchEngine::setMaxTransfersPerHost(int count)
+{
+    m_maxTransfersPerHost = std::max(1, count);
+    startQueued();
+}
+
+bool FetchEngine::isRemote(const QUrl& url)
+{
+    return url.scheme() == "http" || url.scheme() == "https";
+}
+
+QString FetchEngine::transferKey(const QUrl& url, const Validators& validators)
+{
+    // Different validators can get different answers (304 vs 200)
+    return url.toString(QUrl::FullyEncoded) + '\n'
+         + QString::fromLatin1(validators.etag) + '\n'
+         + QString::fromLatin1(validators.lastModified);
+}
+
+void FetchEngine::startQueued()
+{
+    // Requests made while quitting stay queued
+    if (!m_network) return;
+
+    // Most urgent first; requests to a saturated host let others overtake them
+    auto it = m_queue.begin();
+    while (it != m_queue.end() && m_running < m_maxTransfers) {
+        const quint64 transferId = it->second;
+        Transfer& transfer = m_transfers[transferId];
+        if (m_runningPerHost.value(transfer.host) >= m_maxTransfersPerHost) {
+            ++it;
+            continue;
+        }
+        it = m_queue.erase(it);
+        start(transferId, transfer);
+    }
+}
+
+void FetchEngine::start(quint64 transferId, Transfer& transfer)
+{
+    ++m_running;
+    ++m_runningPerHost[transfer.host];
+
+    transfer.request.setPriority(requestPriority(transfer.priority));
+    transfer.networkReply = m_network->get(transfer.request);
+    // Counted here: queued transfers may still be cancelled or joined
+    ++m_statistics.requests;
+    if (transfer.request.hasRawHeader("If-None-Match") || transfer.request.hasRawHeader("If-Modified-Since")) {
+        ++m_statistics.conditionalRequests;
+    }
+    connect(transfer.networkReply, &QNetworkReply::downloadProgress, this, [this, transferId](qint64 received) {
+        auto it = m_transfers.find(transferId);
+        if (it != m_transfers.end()) {
+            it->bytesReceived = received;
+        }
+    });
+    connect(transfer.networkReply, &QNetworkReply::finished, this, [this, transferId]() {
+        onFinished(transferId);
+    });
+}
+
+void FetchEngine::release(const Transfer& transfer)
+{
+    --m_running;
+    auto it = m_runningPerHost.find(transfer.host);
+    if (it != m_runningPerHost.end() && --it.value() <= 0) {
+        m_runningPerHost.erase(it);
+    }
+}
+
+void FetchEngine::onFinished(quint64 transferId)
+{
+    auto it = m_transfers.find(transferId);
+    if (it == m_transfers.end()) return;
+    const Transfer transfer = it.value();
+    m_transfers.erase(it);
+    m_transfersByKey.remove(transfer.key);
+
+    // Hand the slot on before notifying; handlers may queue follow-up requests
+    release(transfer);
+    startQueued();
+
+    QNetworkReply* networkReply = transfer.networkReply;
+    networkReply->deleteLater();
+
+    // Read the response once; QByteArray copies share the data
+    const int statusCode = networkReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    QString errorString;
+    QByteArray data;
+    if (networkReply->error() != QNetworkReply::NoError) {
+        errorString = networkReply->errorString();
+        ++m_statistics.errors;
+    } else if (statusCode == 304) {
+        ++m_statistics.notModified;
+    } else {
+        data = networkReply->readAll();
+        m_statistics.bodyBytes += static_cast<quint64>(data.size());
+        m_statistics.receivedBytes += static_cast<quint64>(wireBodySize(networkReply, transfer.bytesReceived));
+    }
+    Validators validators;
+    validators.etag = networkReply->rawHeader("ETag");
+    validators.lastModified = networkReply->rawHeader("Last-Modified");
+
+    for (const QPointer<FetchReply>& reply : transfer.subscribers) {
+        // A subscriber's finished() handler may delete other subscribers
+        if (!reply || reply->m_finished) continue;
+        reply->m_statusCode = statusCode;
+        reply->m_errorString = errorString;
+        reply->m_data = data;
+        reply->m_validators = validators;
+        reply->m_finished = true;
+        emit reply->finished();
+    }
+}
+
+void FetchEngine::detach(FetchReply* reply)
+{
+    auto it = m_transfers.find(reply->m_transfer);
+    if (it == m_transfers.end()) return;
+
+    Transfer& transfer = it.value();
+    transfer.subscribers.removeAll(reply);
+    // Null entries are subscribers deleted without detaching (engine gone meanwhile)
+    transfer.subscribers.removeAll(nullptr);
+    if (!transfer.subscribers.isEmpty()) {
+        reprioritize(it.key());
+        return;
+    }
+
+    // Nobody waits for this transfer anymore
+    const quint64 transferId = it.key();
+    QNetworkReply* networkReply = transfer.networkReply;
+    if (networkReply) {
+        release(transfer);
+    } else {
+        m_queue.erase({transfer.priority, transferId});
+    }
+    m_transfersByKey.remove(transfer.key);
+    m_transfers.erase(it);
+
+    if (networkReply) {
+        disconnect(networkReply, nullptr, this, nullptr);
+        networkReply->abort();
+        networkReply->deleteLater();
+        startQueued();
+    }
+}
+
+void FetchEngine::shutdown()
+{
+    // Subscribers are not notified; their transfers are simply gone
+    for (const Transfer& transfer : m_transfers) {
+        if (transfer.networkReply) {
+            disconnect(transfer.networkReply, nullptr, this, nullptr);
+            transfer.networkReply->abort();
+        }
+    }
+    m_transfers.clear();
+    m_transfersByKey.clear();
+    m_queue.clear();
+    m_runningPerHost.clear();
+    m_running = 0;
+
+    // Deletes the replies with it
+    delete m_network;
+    m_network = nullptr;
+}
+
+void FetchEngine::reprioritize(quint64 transferId)
+{
+    auto it = m_transfers.find(transferId);
+    if (it == m_transfers.end()) return;
+
+    // Running transfers keep their slot; only the queue order can change
+    Transfer& transfer = it.value();
+    if (transfer.networkReply) return;
+
+    Priority priority = Priority::Prefetch;
+    for (const QPointer<FetchReply>& reply : transfer.subscribers) {
+        if (reply) {
+            priority = std::min(priority, reply->m_priority);
+        }
+    }
+    if (priority == transfer.priority) return;
+
+    m_queue.erase({transfer.priority, transferId});
+    transfer.priority = priority;
+    m_queue.insert({priority, transferId});
+}
+
+} // namespace Network
+} // namespace LongView
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QNetworkRequest>
+#include <QPointer>
+#include <QString>
+#include <QUrl>
+#include <set>
+#include <utility>
+
+// Forward declarations
+class QNetworkAccessManager;
+class QNetworkReply;
+
+namespace LongView {
+namespace Network {
+
+class FetchEngine;
+
+/**
+ * @brief Urgency of a request, most urgent first
+ */
+enum class Priority {
+    Visible,    // Shown in the viewport
+    Overscan,   // Just outside the viewport, likely to be scrolled in
+    Offscreen,  // Needed, but not on screen
+    Prefetch    // Speculative
+};
+
+/**
+ * @brief Cache validators of a previously fetched response
+ */
+struct Validators {
+    QByteArray etag;
+    QByteArray lastModified;
+
+    bool isEmpty() const { return etag.isEmpty() && lastModified.isEmpty(); }
+};
+
+/**
+ * @brief Result handle of FetchEngine::fetch()
+ *
+ * Owned by the caller; deleting it or calling abort() unsubscribes it from
+ * its transfer, which is cancelled once nobody waits for it anymore.
+ * finished() is emitted exactly once unless aborted.
+ */
+class FetchReply final : public QObject {
+    Q_OBJECT
+    Q_DISABLE_COPY(FetchReply)
+
+public:
+    ~FetchReply() override;
+
+    QUrl url() const { return m_url; }
+    bool isFinished() const { return m_finished; }
+
+    bool hasError() const { return !m_errorString.isEmpty(); }
+    QString errorString() const { return m_errorString; }
+    int statusCode() const { return m_statusCode; }
+
+    /**
+     * @brief Server answered 304: the content matching the request validators is current
+     */
+    bool isNotModified() const { return m_statusCode == 304; }
+
+    // Decompressed response body (empty for 304)
+    const QByteArray& data() const { return m_data; }
+    // Validators of this response, to send with the next request
+    const Validators& validators() const { return m_validators; }
+
+    void abort();
+
+    /**
+     * @brief Change the urgency of the request while it is still queued
+     *
+     * A transfer shared by several replies runs at the highest priority of
+     * any of them.
+     */
+    void setPriority(Priority priority);
+    Priority priority() const { return m_priority; }
+
+signals:
+    void finished();
+
+private:
+    friend class FetchEngine;
+    FetchReply(FetchEngine* engine, const QUrl& url, Priority priority, QObject* parent);
+
+    QPointer<FetchEngine> m_engine;
+    quint64 m_transfer = 0;
+    QUrl m_url;
+    Priority m_priority;
+    QByteArray m_data;
+    Validators m_validators;
+    QString m_errorString;
+    int m_statusCode = 0;
+    bool m_finished = false;
+};
+
+/**
+ * @brief Shared HTTP client for all tiles
+ *
+ * Wraps one QNetworkAccessManager, so connections are kept alive and reused
+ * (HTTP/2 multiplexed where the server supports it) across all tiles and
+ * refreshes. Requests carrying validators are sent as conditional GETs, so
+ * unchanged content costs a 304 without body. Responses are transparently
+ * decompressed (gzip/deflate, plus whatever else Qt negotiates).
+ *
+ * Identical requests (same URL and validators) issued while one is in flight
+ * share that transfer: the network is hit once and the response fans out to
+ * every FetchReply.
+ *
+ * Requests are queued by Priority and started as slots become free, within a
+ * global limit and a limit per host. Queued requests can be reprioritized at
+ * any time, e.g. as tiles scroll into view, so a large dashboard never makes
+ * the visible tiles wait behind off-screen ones. Equal priorities start in
+ * request order.
+ *
+ * Byte and request counters make the traffic of a refresh cycle measurable,
+ * e.g. against a local test server. Bodies are counted both as received on
+ * the wire and decompressed, so compression and 304 savings show up.
+ */
+class FetchEngine : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int kDefaultTransferTimeout = 30000;  // ms
+    static constexpr int kDefaultMaxTransfers = 16;
+    static constexpr int kDefaultMaxTransfersPerHost = 6;  // What browsers allow per host
+
+    struct Statistics {
+        quint64 requests = 0;     // Network requests actually sent
+        quint64 coalesced = 0;    // fetch() calls served by a transfer already in flight
+        quint64 queued = 0;       // Requests that had to wait for a free slot
+        quint64 conditionalRequests = 0;
+        quint64 notModified = 0;
+        quint64 errors = 0;
+        quint64 bodyBytes = 0;      // Decompressed body bytes received
+        quint64 receivedBytes = 0;  // Body bytes as transferred, before decompression
+    };
+
+    /**
+     * @brief The engine shared by the whole application
+     */
+    static FetchEngine& getInstance();
+
+    // Separate engines are possible, e.g. for tests against a local server
+    explicit FetchEngine(QObject* parent = nullptr);
+    ~FetchEngine() override;
+
+    /**
+     * @brief GET @p url, conditionally if @p validators are given
+     * @param parent Parent of the returned reply
+     * @param priority Initial priority; see FetchReply::setPriority()
+     */
+    FetchReply* fetch(const QUrl& url, const Validators& validators = Validators(), QObject* parent = nullptr,
+                      Priority priority = Priority::Visible);
+
+    void setTransferTimeout(int msec);
+    int transferTimeout() const { return m_transferTimeout; }
+
+    // Concurrency limits; lowering them does not abort running transfers
+    void setMaxTransfers(int count);
+    int maxTransfers() const { return m_maxTransfers; }
+    void setMaxTransfersPerHost(int count);
+    int maxTransfersPerHost() const { return m_maxTransfersPerHost; }
+
+    Statistics statistics() const { return m_statistics; }
+    void resetStatistics() { m_statistics = Statistics(); }
+
+    // Null once the application is quitting
+    QNetworkAccessManager* networkAccessManager() const { return m_network; }
+
+    static bool isRemote(const QUrl& url);
+
+    /**
+     * @brief Number of network transfers currently in flight
+     */
+    int transferCount() const { return m_running; }
+
+    /**
+     * @brief Number of requests waiting for a free slot
+     */
+    int queuedCount() const { return static_cast<int>(m_queue.size()); }
+
+private:
+    friend class FetchReply;
+
+    struct Transfer {
+        QString key;
+        QString host;
+        QNetworkRequest request;
+        QNetworkReply* networkReply = nullptr;  // Null while queued
+        qint64 bytesReceived = 0;  // Last downloadProgress() count
+        Priority priority = Priority::Visible;
+        QList<QPointer<FetchReply>> subscribers;
+    };
+
+    // Ordered by priority, then by transfer id (request order)
+    using QueueKey = std::pair<Priority, quint64>;
+
+    static QString transferKey(const QUrl& url, const Validators& validators);
+    void startQueued();
+    void start(quint64 transferId, Transfer& transfer);
+    void release(const Transfer& transfer);
+    void onFinished(quint64 transferId);
+    void detach(FetchReply* reply);
+    void reprioritize(quint64 transferId);
+    void shutdown();
+
+    QNetworkAccessManager* m_network = nullptr;
+    QHash<quint64, Transfer> m_transfers;
+    QHash<QString, quint64> m_transfersByKey;
+    std::set<QueueKey> m_queue;
+    QHash<QString, int> m_runningPerHost;
+    int m_running = 0;
+    quint64 m_nextTransferId = 0;
+    int m_maxTransfers = kDefaultMaxTransfers;
+    int m_maxTransfersPerHost = kDefaultMaxTransfersPerHost;
+    int m_transferTimeout = kDefaultTransferTimeout;
+    Statistics m_statistics;
+};
+
+} // namespace Network
+} // namespace LongView
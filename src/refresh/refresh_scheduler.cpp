@@ -0,0 +1,422 @@
+#include "refresh_scheduler.h"
+#include "../tiles/base/tile.h"
+#include <QEvent>
+#include <QRandomGenerator>
+#include <QTimer>
+#include <algorithm>
+#include <limits>
+
+namespace LongView {
+namespace Refresh {
+
+namespace {
+    // Min-heap on due time (std heap functions build max-heaps)
+    template <typename Node>
+    bool laterDue(const Node& a, const Node& b)
+    {
+        return a.due > b.due;
+    }
+
+    // Rebuild the heap once stale nodes outnumber live ones by this much
+    constexpr size_t kMaxStaleNodes = 64;
+
+    using Policy = RefreshScheduler::ThrottlePolicy;
+
+    // Nothing hidden needs refreshing until it is seen again; completed
+    // tiles stay up to date, just less eagerly
+    constexpr Policy kPausedUntilRevealed{Policy::Mode::Pause, 1.0, true};
+    constexpr Policy kCompletedPolicy{Policy::Mode::SlowDown, 4.0, false};
+    constexpr Policy kVisiblePolicy{Policy::Mode::Full, 1.0, false};
+}
+
+RefreshScheduler::RefreshScheduler(QObject* parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+    , m_stateCheckTimer(new QTimer(this))
+{
+    m_clock.start();
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, &RefreshScheduler::onTimeout);
+
+    m_stateCheckTimer->setSingleShot(true);
+    m_stateCheckTimer->setInterval(kStateCheckDelay);
+    connect(m_stateCheckTimer, &QTimer::timeout, this, &RefreshScheduler::runStateChecks);
+
+    m_policies[static_cast<size_t>(TileState::Minimized)] = kPausedUntilRevealed;
+    m_policies[static_cast<size_t>(TileState::Offscreen)] = kPausedUntilRevealed;
+    m_policies[static_cast<size_t>(TileState::Collapsed)] = kPausedUntilRevealed;
+    m_policies[static_cast<size_t>(TileState::Completed)] = kCompletedPolicy;
+    m_policies[static_cast<size_t>(TileState::Visible)] = kVisiblePolicy;
+}
+
+RefreshScheduler::~RefreshScheduler()
+{
+    clear();
+}
+
+void RefreshScheduler::schedule(Tiles::Tile* tile, std::chrono::milliseconds interval,
+                                const QString& alignmentKey)
+{
+    if (!tile || interval.count() <= 0) return;
+
+    auto [it, inserted] = m_entries.try_emplace(tile);
+    Entry& entry = it->second;
+    if (inserted) {
+        entry.tile = tile;
+        connect(tile, &QObject::destroyed, this, [this, tile]() {
+            auto it = m_entries.find(tile);
+            if (it != m_entries.end()) {
+                releaseAlignment(it->second);
+                m_entries.erase(it);
+            }
+            m_pendingStateChecks.erase(tile);
+        });
+        connect(tile, &Tiles::Tile::expandedChanged, this, [this, tile]() { requestStateCheck(tile); });
+        connect(tile, &Tiles::Tile::completedChanged, this, [this, tile]() { requestStateCheck(tile); });
+        tile->installEventFilter(this);
+    }
+    if (entry.alignmentKey != alignmentKey) {
+        releaseAlignment(entry);
+        entry.alignmentKey = alignmentKey;
+        if (!alignmentKey.isEmpty()) {
+            ++m_alignment[alignmentKey].members;
+        }
+    }
+    entry.interval = interval.count();
+    entry.scheduledAt = now();
+    entry.lastRun = -1;
+    entry.state = evaluateState(tile);
+    enqueue(entry, aligned(entry, entry.scheduledAt + jittered(period(entry))));
+    armTimer();
+}
+
+void RefreshScheduler::unschedule(const Tiles::Tile* tile)
+{
+    auto it = m_entries.find(tile);
+    if (it == m_entries.end()) return;
+
+    detach(it->second.tile);
+    releaseAlignment(it->second);
+    m_entries.erase(it);
+    m_pendingStateChecks.erase(tile);
+    // The heap node goes stale; drop it early if the heap is mostly garbage
+    compactHeap();
+    armTimer();
+}
+
+void RefreshScheduler::clear()
+{
+    for (auto& [key, entry] : m_entries) {
+        detach(entry.tile);
+    }
+    m_entries.clear();
+    m_heap.clear();
+    m_alignment.clear();
+    m_pendingStateChecks.clear();
+    m_checkAllStates = false;
+    m_timer->stop();
+    m_stateCheckTimer->stop();
+}
+
+bool RefreshScheduler::isScheduled(const Tiles::Tile* tile) const
+{
+    return m_entries.count(tile) > 0;
+}
+
+void RefreshScheduler::refreshNow(Tiles::Tile* tile)
+{
+    auto it = m_entries.find(tile);
+    if (it == m_entries.end()) return;
+
+    Entry& entry = it->second;
+    entry.lastRun = now();
+    enqueue(entry, entry.lastRun + jittered(period(entry)));
+    armTimer();
+
+    tile->refresh();
+    emit tileRefreshed(tile);
+}
+
+QDateTime RefreshScheduler::nextDue(const Tiles::Tile* tile) const
+{
+    auto it = m_entries.find(tile);
+    return it != m_entries.end() ? toDateTime(it->second.nextDue) : QDateTime();
+}
+
+QDateTime RefreshScheduler::lastRun(const Tiles::Tile* tile) const
+{
+    auto it = m_entries.find(tile);
+    return it != m_entries.end() ? toDateTime(it->second.lastRun) : QDateTime();
+}
+
+std::chrono::milliseconds RefreshScheduler::interval(const Tiles::Tile* tile) const
+{
+    auto it = m_entries.find(tile);
+    return std::chrono::milliseconds(it != m_entries.end() ? it->second.interval : 0);
+}
+
+void RefreshScheduler::setJitter(double fraction)
+{
+    m_jitter = std::clamp(fraction, 0.0, 1.0);
+}
+
+void RefreshScheduler::setTickInterval(int msec)
+{
+    m_tickInterval = std::max(1, msec);
+    armTimer();
+}
+
+void RefreshScheduler::setThrottlePolicy(TileState state, const ThrottlePolicy& policy)
+{
+    ThrottlePolicy& slot = m_policies[static_cast<size_t>(state)];
+    slot = policy;
+    slot.factor = std::max(1.0, policy.factor);
+}
+
+RefreshScheduler::ThrottlePolicy RefreshScheduler::throttlePolicy(TileState state) const
+{
+    return m_policies[static_cast<size_t>(state)];
+}
+
+RefreshScheduler::TileState RefreshScheduler::tileState(const Tiles::Tile* tile) const
+{
+    auto it = m_entries.find(tile);
+    return it != m_entries.end() ? it->second.state : TileState::Visible;
+}
+
+void RefreshScheduler::updateTileStates()
+{
+    if (m_entries.empty()) return;
+    m_checkAllStates = true;
+    if (!m_stateCheckTimer->isActive()) {
+        m_stateCheckTimer->start();
+    }
+}
+
+void RefreshScheduler::updateTileState(const Tiles::Tile* tile)
+{
+    if (m_entries.count(tile) > 0) {
+        requestStateCheck(tile);
+    }
+}
+
+bool RefreshScheduler::eventFilter(QObject* watched, QEvent* event)
+{
+    // Also delivered (spontaneously) when the window is minimized or restored
+    if (event->type() == QEvent::Show || event->type() == QEvent::Hide) {
+        requestStateCheck(static_cast<const Tiles::Tile*>(watched));
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+qint64 RefreshScheduler::jittered(qint64 interval) const
+{
+    if (m_jitter <= 0.0) return interval;
+    // Uniform in [-jitter/2, +jitter/2] of the interval, so the mean period is unchanged
+    const double offset = (QRandomGenerator::global()->generateDouble() - 0.5) * m_jitter;
+    return std::max<qint64>(1, interval + static_cast<qint64>(offset * static_cast<double>(interval)));
+}
+
+qint64 RefreshScheduler::period(const Entry& entry) const
+{
+    // Paused tiles are still checked once per interval, just not refreshed
+    const ThrottlePolicy& policy = m_policies[static_cast<size_t>(entry.state)];
+    if (policy.mode == ThrottlePolicy::Mode::SlowDown) {
+        return static_cast<qint64>(static_cast<double>(entry.interval) * policy.factor);
+    }
+    return entry.interval;
+}
+
+qint64 RefreshScheduler::aligned(const Entry& entry, qint64 due)
+{
+    // Throttled tiles run on their own cadence until they are visible again
+    if (entry.alignmentKey.isEmpty() || period(entry) != entry.interval) return due;
+
+    auto it = m_alignment.find(entry.alignmentKey);
+    if (it == m_alignment.end()) return due;
+
+    // The first member to be queued in a cycle picks the due time for all
+    AlignmentGroup& group = it.value();
+    if (group.interval == entry.interval && group.nextDue > now()) {
+        return group.nextDue;
+    }
+    if (group.interval != entry.interval && group.nextDue > now()) {
+        // The key's current cadence belongs to members with another interval
+        return due;
+    }
+    group.interval = entry.interval;
+    group.nextDue = due;
+    return due;
+}
+
+void RefreshScheduler::releaseAlignment(const Entry& entry)
+{
+    if (entry.alignmentKey.isEmpty()) return;
+    auto it = m_alignment.find(entry.alignmentKey);
+    if (it != m_alignment.end() && --it.value().members <= 0) {
+        m_alignment.erase(it);
+    }
+}
+
+QDateTime RefreshScheduler::toDateTime(qint64 msec) const
+{
+    if (msec < 0) return QDateTime();
+    return QDateTime::currentDateTime().addMSecs(msec - now());
+}
+
+void RefreshScheduler::enqueue(Entry& entry, qint64 due)
+{
+    entry.nextDue = due;
+    entry.generation = ++m_nextGeneration;
+    // Requeueing leaves the previous node behind as garbage
+    compactHeap();
+    m_heap.push_back({due, entry.generation, entry.tile});
+    std::push_heap(m_heap.begin(), m_heap.end(), laterDue<HeapNode>);
+}
+
+bool RefreshScheduler::isStale(const HeapNode& node) const
+{
+    auto it = m_entries.find(node.tile);
+    return it == m_entries.end() || it->second.generation != node.generation;
+}
+
+void RefreshScheduler::compactHeap()
+{
+    if (m_heap.size() <= 2 * m_entries.size() + kMaxStaleNodes) return;
+
+    m_heap.erase(std::remove_if(m_heap.begin(), m_heap.end(),
+                                [this](const HeapNode& node) { return isStale(node); }),
+                 m_heap.end());
+    std::make_heap(m_heap.begin(), m_heap.end(), laterDue<HeapNode>);
+}
+
+void RefreshScheduler::armTimer()
+{
+    while (!m_heap.empty() && isStale(m_heap.front())) {
+        std::pop_heap(m_heap.begin(), m_heap.end(), laterDue<HeapNode>);
+        m_heap.pop_back();
+    }
+    if (m_heap.empty()) {
+        m_timer->stop();
+        return;
+    }
+
+    // Round up to the next tick so refreshes due within one tick share a timeout
+    const qint64 due = m_heap.front().due;
+    const qint64 fireAt = ((due + m_tickInterval - 1) / m_tickInterval) * m_tickInterval;
+    const qint64 delay = std::max<qint64>(0, fireAt - now());
+    m_timer->start(static_cast<int>(std::min<qint64>(delay, std::numeric_limits<int>::max())));
+}
+
+void RefreshScheduler::onTimeout()
+{
+    // Collect and reschedule first: refresh() may schedule or unschedule tiles
+    const qint64 current = now();
+    std::vector<Tiles::Tile*> due;
+    while (!m_heap.empty() && m_heap.front().due <= current) {
+        std::pop_heap(m_heap.begin(), m_heap.end(), laterDue<HeapNode>);
+        const HeapNode node = m_heap.back();
+        m_heap.pop_back();
+        if (isStale(node)) continue;
+
+        Entry& entry = m_entries[node.tile];
+
+        // Catch state changes that happened without a signal or event;
+        // the entry is requeued according to its new state
+        const TileState state = evaluateState(entry.tile);
+        if (state != entry.state) {
+            applyState(entry, state);
+            continue;
+        }
+
+        if (m_policies[static_cast<size_t>(state)].mode == ThrottlePolicy::Mode::Pause) {
+            enqueue(entry, current + jittered(period(entry)));
+            continue;
+        }
+
+        entry.lastRun = current;
+        // Next period counts from now, so a stalled event loop does not cause a burst
+        enqueue(entry, aligned(entry, current + jittered(period(entry))));
+        due.push_back(entry.tile);
+    }
+
+    for (Tiles::Tile* tile : due) {
+        // An earlier refresh may have destroyed or unscheduled this tile
+        if (m_entries.count(tile) == 0) continue;
+        tile->refresh();
+        emit tileRefreshed(tile);
+    }
+
+    armTimer();
+}
+
+RefreshScheduler::TileState RefreshScheduler::evaluateState(const Tiles::Tile* tile)
+{
+    if (tile->window()->isMinimized()) return TileState::Minimized;
+    // visibleRegion() is clipped by all ancestors, including scrolled viewports
+    if (!tile->isVisible() || tile->visibleRegion().isEmpty()) return TileState::Offscreen;
+    if (!tile->isExpanded()) return TileState::Collapsed;
+    if (tile->isCompleted()) return TileState::Completed;
+    return TileState::Visible;
+}
+
+void RefreshScheduler::applyState(Entry& entry, TileState state)
+{
+    if (state == entry.state) return;
+
+    const ThrottlePolicy& left = m_policies[static_cast<size_t>(entry.state)];
+    const ThrottlePolicy& entered = m_policies[static_cast<size_t>(state)];
+    entry.state = state;
+
+    const qint64 current = now();
+    const qint64 base = entry.lastRun >= 0 ? entry.lastRun : entry.scheduledAt;
+    if (left.refreshOnReveal && entered.mode != ThrottlePolicy::Mode::Pause
+        && current - base >= entry.interval) {
+        // Due on the next tick
+        enqueue(entry, current);
+    } else {
+        enqueue(entry, aligned(entry, std::max(current, base + jittered(period(entry)))));
+    }
+    armTimer();
+    emit tileStateChanged(entry.tile, state);
+}
+
+void RefreshScheduler::requestStateCheck(const Tiles::Tile* tile)
+{
+    m_pendingStateChecks.insert(tile);
+    if (!m_stateCheckTimer->isActive()) {
+        m_stateCheckTimer->start();
+    }
+}
+
+void RefreshScheduler::runStateChecks()
+{
+    // Snapshot first: tileStateChanged() handlers may (un)schedule tiles
+    std::vector<const Tiles::Tile*> tiles;
+    if (m_checkAllStates) {
+        tiles.reserve(m_entries.size());
+        for (const auto& [tile, entry] : m_entries) {
+            tiles.push_back(tile);
+        }
+    } else {
+        tiles.assign(m_pendingStateChecks.begin(), m_pendingStateChecks.end());
+    }
+    m_pendingStateChecks.clear();
+    m_checkAllStates = false;
+
+    for (const Tiles::Tile* tile : tiles) {
+        auto it = m_entries.find(tile);
+        if (it != m_entries.end()) {
+            applyState(it->second, evaluateState(it->second.tile));
+        }
+    }
+}
+
+void RefreshScheduler::detach(Tiles::Tile* tile)
+{
+    tile->removeEventFilter(this);
+    disconnect(tile, nullptr, this, nullptr);
+}
+
+} // namespace Refresh
+} // namespace LongView
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <QObject>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+#include <array>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Forward declarations
+class QTimer;
+class QEvent;
+
+namespace LongView {
+
+namespace Tiles {
+class Tile;
+}
+
+namespace Refresh {
+
+/**
+ * @brief Drives Tile::refresh() for all tiles of a dashboard from one timer
+ *
+ * Scheduled tiles sit in a min-heap ordered by their next due time, and a
+ * single QTimer is armed for the earliest one. Due times are rounded up to
+ * the tick interval, so refreshes falling into the same tick run together
+ * in one timer callback. Each period is randomly stretched or shortened by
+ * up to half the jitter fraction, which spreads tiles with equal refresh
+ * frequencies apart instead of refreshing them all at once.
+ *
+ * Refreshes are throttled by each tile's effective state (minimized window,
+ * off-screen, collapsed, completed) according to a per-state ThrottlePolicy.
+ * Paused tiles keep their heap slot and are only re-checked when due, so a
+ * state change that emits no signal is still picked up within one interval.
+ *
+ * Tiles scheduled with the same alignment key and interval (typically tiles
+ * showing the same source) share their due times, so they refresh in the
+ * same timer callback and their loads coalesce into a single fetch.
+ *
+ * Tiles are unscheduled automatically when destroyed.
+ */
+class RefreshScheduler final : public QObject {
+    Q_OBJECT
+    Q_DISABLE_COPY(RefreshScheduler)
+
+public:
+    static constexpr int kDefaultTickInterval = 250;  // ms
+    static constexpr double kDefaultJitter = 0.1;     // fraction of the refresh interval
+    static constexpr int kStateCheckDelay = 100;      // ms; batches visibility/state checks
+
+    /**
+     * @brief Effective tile state, most restrictive first
+     */
+    enum class TileState { Minimized, Offscreen, Collapsed, Completed, Visible };
+    Q_ENUM(TileState)
+
+    struct ThrottlePolicy {
+        enum class Mode { Full, SlowDown, Pause };
+        Mode mode = Mode::Full;
+        double factor = 1.0;           // Period multiplier in SlowDown mode
+        bool refreshOnReveal = false;  // Refresh right away when leaving this state if a refresh is overdue
+    };
+
+    explicit RefreshScheduler(QObject* parent = nullptr);
+    ~RefreshScheduler() override;
+
+    /**
+     * @brief Refresh @p tile every @p interval, replacing any previous schedule
+     *
+     * The first refresh is due one (jittered) interval from now, or with
+     * the other tiles of @p alignmentKey that have the same interval.
+     */
+    void schedule(Tiles::Tile* tile, std::chrono::milliseconds interval,
+                  const QString& alignmentKey = QString());
+    void unschedule(const Tiles::Tile* tile);
+    void clear();
+
+    bool isScheduled(const Tiles::Tile* tile) const;
+    int scheduledCount() const { return static_cast<int>(m_entries.size()); }
+
+    /**
+     * @brief Refresh a scheduled tile immediately and restart its period
+     */
+    void refreshNow(Tiles::Tile* tile);
+
+    // Per-tile timestamps; invalid QDateTime if not scheduled / not run yet
+    QDateTime nextDue(const Tiles::Tile* tile) const;
+    QDateTime lastRun(const Tiles::Tile* tile) const;
+    std::chrono::milliseconds interval(const Tiles::Tile* tile) const;
+
+    /**
+     * @brief Random variation of each period as a fraction of the interval
+     * @param fraction 0 disables jitter; clamped to [0, 1]
+     */
+    void setJitter(double fraction);
+    double jitter() const { return m_jitter; }
+
+    /**
+     * @brief Granularity at which due refreshes are coalesced
+     */
+    void setTickInterval(int msec);
+    int tickInterval() const { return m_tickInterval; }
+
+    // Throttling
+    void setThrottlePolicy(TileState state, const ThrottlePolicy& policy);
+    ThrottlePolicy throttlePolicy(TileState state) const;
+
+    /**
+     * @brief State of a scheduled tile as of its last check
+     */
+    TileState tileState(const Tiles::Tile* tile) const;
+
+    /**
+     * @brief Re-check the state of all scheduled tiles soon, e.g. after scrolling
+     *
+     * Show/hide, expand and completion changes of scheduled tiles are noticed
+     * automatically; this covers tiles clipped by a scrolled viewport.
+     */
+    void updateTileStates();
+
+    /**
+     * @brief Re-check the state of one scheduled tile soon
+     *
+     * For state changes made without the tile's own signals, e.g. batched
+     * expand/collapse or completion of a group's items.
+     */
+    void updateTileState(const Tiles::Tile* tile);
+
+signals:
+    void tileRefreshed(LongView::Tiles::Tile* tile);
+    void tileStateChanged(LongView::Tiles::Tile* tile, LongView::Refresh::RefreshScheduler::TileState state);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    struct Entry {
+        Tiles::Tile* tile = nullptr;
+        qint64 interval = 0;
+        qint64 scheduledAt = 0;
+        qint64 nextDue = -1;
+        qint64 lastRun = -1;
+        quint64 generation = 0;  // Matches the entry's live heap node
+        TileState state = TileState::Visible;
+        QString alignmentKey;
+    };
+
+    // Shared cadence of the tiles scheduled under one alignment key
+    struct AlignmentGroup {
+        qint64 interval = 0;
+        qint64 nextDue = -1;
+        int members = 0;
+    };
+
+    // Heap nodes are never removed in place; nodes whose generation no
+    // longer matches their entry are stale and skipped when popped
+    struct HeapNode {
+        qint64 due;
+        quint64 generation;
+        const Tiles::Tile* tile;
+    };
+
+    qint64 now() const { return m_clock.elapsed(); }
+    qint64 jittered(qint64 interval) const;
+    qint64 period(const Entry& entry) const;
+    qint64 aligned(const Entry& entry, qint64 due);
+    void releaseAlignment(const Entry& entry);
+    QDateTime toDateTime(qint64 msec) const;
+    void enqueue(Entry& entry, qint64 due);
+    bool isStale(const HeapNode& node) const;
+    void compactHeap();
+    void armTimer();
+    void onTimeout();
+
+    static TileState evaluateState(const Tiles::Tile* tile);
+    void applyState(Entry& entry, TileState state);
+    void requestStateCheck(const Tiles::Tile* tile);
+    void runStateChecks();
+    void detach(Tiles::Tile* tile);
+
+    std::unordered_map<const Tiles::Tile*, Entry> m_entries;
+    std::vector<HeapNode> m_heap;
+    quint64 m_nextGeneration = 0;
+    QHash<QString, AlignmentGroup> m_alignment;
+
+    QElapsedTimer m_clock;
+    QTimer* m_timer = nullptr;
+    double m_jitter = kDefaultJitter;
+    int m_tickInterval = kDefaultTickInterval;
+
+    std::array<ThrottlePolicy, 5> m_policies;  // Indexed by TileState
+    std::unordered_set<const Tiles::Tile*> m_pendingStateChecks;
+    bool m_checkAllStates = false;
+    QTimer* m_stateCheckTimer = nullptr;
+};
+
+} // namespace Refresh
+} // namespace LongView
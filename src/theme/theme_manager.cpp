@@ -0,0 +1,93 @@
+#include "theme_manager.h"
+
+#include <QApplication>
+#include <QFile>
+#include <QDebug>
+
+namespace LongView {
+namespace Theme {
+
+namespace {
+    // Used when a theme's QSS cannot be read
+    const char* const kFallbackStyleSheet =
+        "#LongViewTile{background:#f5f5f5;border:1px solid #ddd;border-radius:4px}"
+        "#LongViewTile QPushButton{background:transparent;border:none}"
+        "#LongViewTile QCheckBox{background:transparent}"
+        "#LongViewPlaceholder{color:#888;padding:20px}";
+}
+
+ThemeManager& ThemeManager::getInstance()
+{
+    static ThemeManager instance;
+    return instance;
+}
+
+ThemeManager::ThemeManager()
+    : QObject(nullptr)
+{
+    registerTheme("light", ":/assets/styles/tile.qss");
+    registerTheme("dark", ":/assets/styles/tile_dark.qss");
+}
+
+void ThemeManager::ensureApplied()
+{
+    if (!m_currentTheme.isEmpty()) return;
+
+    // Allow picking the initial theme without code changes
+    const QString requested = qEnvironmentVariable("LONGVIEW_THEME");
+    if (!requested.isEmpty() && setTheme(requested)) return;
+
+    setTheme(kDefaultTheme);
+}
+
+bool ThemeManager::setTheme(const QString& name)
+{
+    if (!m_themePaths.contains(name)) {
+        qWarning() << "Unknown theme:" << name;
+        return false;
+    }
+    if (name == m_currentTheme) return true;
+
+    auto* app = qobject_cast<QApplication*>(QCoreApplication::instance());
+    if (!app) {
+        qWarning() << "Cannot apply theme without a QApplication instance";
+        return false;
+    }
+
+    // One application-wide style sheet; Qt repolishes all widgets once
+    app->setStyleSheet(loadStyleSheet(name));
+    m_currentTheme = name;
+    emit themeChanged(name);
+    return true;
+}
+
+void ThemeManager::registerTheme(const QString& name, const QString& qssPath)
+{
+    m_themePaths.insert(name, qssPath);
+    m_styleSheets.remove(name);
+}
+
+QStringList ThemeManager::availableThemes() const
+{
+    return m_themePaths.keys();
+}
+
+QString ThemeManager::loadStyleSheet(const QString& name)
+{
+    auto it = m_styleSheets.constFind(name);
+    if (it != m_styleSheets.constEnd()) return it.value();
+
+    QString qss;
+    QFile f(m_themePaths.value(name));
+    if (f.open(QIODevice::ReadOnly)) {
+        qss = QString::fromUtf8(f.readAll());
+    } else {
+        qWarning() << "Theme QSS not found, using fallback:" << f.fileName();
+        qss = QString::fromLatin1(kFallbackStyleSheet);
+    }
+    m_styleSheets.insert(name, qss);
+    return qss;
+}
+
+} // namespace Theme
+} // namespace LongView
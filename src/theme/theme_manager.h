@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+
+namespace LongView {
+namespace Theme {
+
+/**
+ * @brief Application-wide tile theming
+ * 
+ * Applies the tile style sheet once on the QApplication instead of on every
+ * tile, so Qt parses it a single time and all tiles share one style sheet
+ * style. Switching themes replaces the application style sheet, which
+ * triggers a single repolish of all widgets.
+ */
+class ThemeManager : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr const char* kDefaultTheme = "light";
+
+    // Singleton pattern
+    static ThemeManager& getInstance();
+
+    ThemeManager(const ThemeManager&) = delete;
+    ThemeManager& operator=(const ThemeManager&) = delete;
+
+    /**
+     * @brief Apply the default theme unless a theme has been applied already
+     */
+    void ensureApplied();
+
+    /**
+     * @brief Apply a registered theme to the whole application
+     * @param name Theme name, e.g. "light" or "dark"
+     * @return false if the theme is unknown
+     */
+    bool setTheme(const QString& name);
+    QString currentTheme() const { return m_currentTheme; }
+
+    /**
+     * @brief Register (or replace) a theme backed by a QSS file or resource
+     */
+    void registerTheme(const QString& name, const QString& qssPath);
+    QStringList availableThemes() const;
+
+signals:
+    void themeChanged(const QString& name);
+
+private:
+    ThemeManager();
+
+    QString loadStyleSheet(const QString& name);
+
+    QHash<QString, QString> m_themePaths;
+    QHash<QString, QString> m_styleSheets;  // QSS text, read once per theme
+    QString m_currentTheme;
+};
+
+} // namespace Theme
+} // namespace LongView
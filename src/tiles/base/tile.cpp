@@ -1,4 +1,5 @@
 #include "tile.h"
+#include "../../theme/theme_manager.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -6,16 +7,43 @@
 #include <QPushButton>
 #include <QLabel>
 #include <QStyle>
-#include <QFile>
 #include <QString>
 #include <QSignalBlocker>
 #include <QSizePolicy>
 #include <QEvent>
 #include <QSize>
+#include <QTimer>
+#include <QPainter>
+#include <QMouseEvent>
+#include <QKeyEvent>
+#include <QHelpEvent>
+#include <QToolTip>
+#include <QStyleOptionFocusRect>
+#include <algorithm>
 #include <QDebug>
 
 namespace {
-// Empty namespace - UI constants moved to header
+// UI constants live in the header; this holds process-wide tile defaults
+int s_defaultContentReleaseDelay = -1;  // Keep lazily built content forever
+
+LongView::Tiles::Tile::HeaderMode initialHeaderMode()
+{
+    using HeaderMode = LongView::Tiles::Tile::HeaderMode;
+    const QByteArray env = qgetenv("LONGVIEW_TILE_HEADER").toLower();
+    if (env == "painted") return HeaderMode::Painted;
+    if (env == "widgets") return HeaderMode::Widgets;
+#ifdef LONGVIEW_PAINTED_TILE_HEADER
+    return HeaderMode::Painted;
+#else
+    return HeaderMode::Widgets;
+#endif
+}
+
+LongView::Tiles::Tile::HeaderMode& defaultHeaderModeRef()
+{
+    static LongView::Tiles::Tile::HeaderMode s_mode = initialHeaderMode();
+    return s_mode;
+}
 }
 
 namespace LongView {
@@ -24,6 +52,8 @@ namespace Tiles {
 Tile::Tile(Kind kind, QWidget* parent)
     : QWidget(parent)
     , m_kind(kind)
+    , m_headerMode(defaultHeaderModeRef())
+    , m_contentReleaseDelay(s_defaultContentReleaseDelay)
 {
     setObjectName("LongViewTile");
     setupUI();
@@ -42,6 +72,14 @@ void Tile::setupUI()
     m_mainLayout->setContentsMargins(kMargin, kMargin, kMargin, kMargin);
     m_mainLayout->setSpacing(kSpacing);
 
+    if (m_headerMode == HeaderMode::Painted) {
+        // Header is painted into the top margin; no child widgets needed
+        m_mainLayout->setContentsMargins(kMargin, kMargin + kButtonSize + kSpacing, kMargin, kMargin);
+        setFocusPolicy(Qt::TabFocus);
+        loadStyleSheet();
+        return;
+    }
+
     // Header widget
     m_headerWidget = new QWidget(this);
     auto headerLayout = new QHBoxLayout(m_headerWidget);
@@ -74,10 +112,7 @@ void Tile::setupUI()
 
     m_mainLayout->addWidget(m_headerWidget, 0); // No stretch
 
-    // Content widget
-    m_contentWidget = new QWidget(this);
-    m_contentWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    m_mainLayout->addWidget(m_contentWidget, 1); // Take remaining space
+    // Content widget is created on demand (see ensureContent())
 
     // Connect signals
     connect(m_expandButton, &QPushButton::clicked, this, &Tile::onExpandButtonClicked);
@@ -89,25 +124,39 @@ void Tile::setupUI()
 
 void Tile::updateUI()
 {
-    // Defensive assertions
-    Q_ASSERT(m_expandButton);
-    Q_ASSERT(m_completionCheckBox);
-    Q_ASSERT(m_contentWidget);
+    if (m_headerMode == HeaderMode::Widgets) {
+        // Defensive assertions
+        Q_ASSERT(m_expandButton);
+        Q_ASSERT(m_completionCheckBox);
+
+        // Update expand button icon from the shared icon cache
+        m_expandButton->setIcon(TileHeaderPainter::arrowIcon(this, m_expanded));
+        m_expandButton->setText({}); // Clear button text
+    } else {
+        update(headerRect());
+    }
 
-    // Update expand button icon using QStyle
-    m_expandButton->setIcon(style()->standardIcon(
-        m_expanded ? QStyle::SP_ArrowDown : QStyle::SP_ArrowRight
-    ));
-    m_expandButton->setText({}); // Clear button text
+    // Build content the first time the tile is expanded on screen
+    if (m_expanded && isVisible()) {
+        ensureContent();
+    }
 
     // Update content visibility
-    m_contentWidget->setVisible(m_expanded);
+    if (m_contentWidget) {
+        m_contentWidget->setVisible(m_expanded);
+    }
 
-    // Update completion checkbox (block signals to avoid loops)
-    {
-        QSignalBlocker blocker(m_completionCheckBox);
-        m_completionCheckBox->setChecked(m_completed);
+    // Collapsed tiles may drop their lazily built content after a while
+    if (m_expanded) {
+        if (m_contentReleaseTimer) {
+            m_contentReleaseTimer->stop();
+        }
+    } else {
+        scheduleContentRelease();
     }
+
+    // Update completion checkbox (block signals to avoid loops)
+    updateCompletionUI();
 }
 
 void Tile::setExpanded(bool expanded, bool silent)
@@ -137,17 +186,51 @@ void Tile::toggleExpanded()
     setExpanded(!m_expanded);
 }
 
+void Tile::restoreState(bool expanded, bool completed)
+{
+    if (m_expanded == expanded && m_completed == completed) return;
+    m_expanded = expanded;
+    m_completed = completed;
+    updateUI();
+}
+
 void Tile::setTitle(const QString& title)
 {
-    if (m_titleLabel->text() != title) {
-        m_titleLabel->setText(title);
+    if (m_title != title) {
+        m_title = title;
+        if (m_titleLabel) {
+            m_titleLabel->setText(title);
+        } else {
+            update(headerRect());
+        }
         emit titleChanged(title);
     }
 }
 
 QString Tile::title() const
 {
-    return m_titleLabel->text();
+    return m_title;
+}
+
+void Tile::setBadgeText(const QString& text)
+{
+    if (m_badgeText == text) return;
+    m_badgeText = text;
+    
+    if (m_headerMode == HeaderMode::Painted) {
+        update(headerRect());
+        return;
+    }
+    
+    if (!m_badgeLabel) {
+        m_badgeLabel = new QLabel(m_headerWidget);
+        m_badgeLabel->setTextFormat(Qt::PlainText);
+        m_badgeLabel->setAccessibleName("tile-badge");
+        m_badgeLabel->setForegroundRole(QPalette::PlaceholderText);
+        m_headerWidget->layout()->addWidget(m_badgeLabel); // After the stretch: right-aligned
+    }
+    m_badgeLabel->setText(text);
+    m_badgeLabel->setVisible(!text.isEmpty());
 }
 
 void Tile::setContentWidget(QWidget* widget)
@@ -156,12 +239,15 @@ void Tile::setContentWidget(QWidget* widget)
         // Remove old content widget
         if (m_contentWidget) {
             m_mainLayout->removeWidget(m_contentWidget);
-            m_contentWidget->deleteLater(); // deleteLater() automatically reparents to nullptr
+            QWidget* old = m_contentWidget;
+            m_contentWidget = nullptr;
+            discardContent(old);
         }
+        m_contentIsLazy = false;
         
-        // Ensure we always have a valid widget (create placeholder if nullptr)
         if (!widget) {
-            widget = new QWidget(this); // Placeholder widget
+            m_contentWidget = nullptr;
+            return;
         }
         
         // Set new content widget
@@ -172,45 +258,96 @@ void Tile::setContentWidget(QWidget* widget)
     }
 }
 
+void Tile::discardContent(QWidget* widget)
+{
+    widget->hide(); // Stays a child until deleteLater() runs
+    widget->deleteLater();
+}
+
 QWidget* Tile::contentWidget() const
 {
     return m_contentWidget;
 }
 
-void Tile::onExpandButtonClicked()
+void Tile::ensureContent()
 {
-    toggleExpanded();
+    if (m_contentWidget) return;
+    
+    createContent();
+    m_contentIsLazy = m_contentWidget != nullptr;
 }
 
-void Tile::loadStyleSheet()
+void Tile::releaseContent()
 {
-    // Static cache for stylesheet to avoid repeated file reads
-    static QString s_tileQss;
-    if (s_tileQss.isEmpty()) {
-        QFile f(":/assets/styles/tile.qss");
-        if (f.open(QIODevice::ReadOnly)) {
-            s_tileQss = QString::fromUtf8(f.readAll());
-        } else {
-            qWarning() << "Tile QSS not found, using fallback";
-            s_tileQss = QString(); // keep empty; we'll set fallback below
-        }
+    if (!m_contentWidget || !m_contentIsLazy) return;
+    
+    setContentWidget(nullptr);
+}
+
+void Tile::setContentReleaseDelay(int msec)
+{
+    m_contentReleaseDelay = msec;
+    if (m_contentReleaseTimer) {
+        m_contentReleaseTimer->stop();
+    }
+    if (!m_expanded) {
+        scheduleContentRelease();
     }
+}
+
+void Tile::setDefaultContentReleaseDelay(int msec)
+{
+    s_defaultContentReleaseDelay = msec;
+}
+
+int Tile::defaultContentReleaseDelay()
+{
+    return s_defaultContentReleaseDelay;
+}
+
+void Tile::scheduleContentRelease()
+{
+    if (m_contentReleaseDelay < 0 || !m_contentIsLazy) return;
     
-    if (!s_tileQss.isEmpty()) {
-        setStyleSheet(s_tileQss);
-    } else {
-        setStyleSheet(
-            "#LongViewTile{background:#f5f5f5;border:1px solid #ddd;border-radius:4px}"
-            "#LongViewTile QPushButton{background:transparent;border:none}"
-            "#LongViewTile QCheckBox{background:transparent}"
-        );
+    if (!m_contentReleaseTimer) {
+        m_contentReleaseTimer = new QTimer(this);
+        m_contentReleaseTimer->setSingleShot(true);
+        connect(m_contentReleaseTimer, &QTimer::timeout, this, [this]() {
+            if (!m_expanded) {
+                releaseContent();
+            }
+        });
+    }
+    if (!m_contentReleaseTimer->isActive()) {
+        m_contentReleaseTimer->start(m_contentReleaseDelay);
+    }
+}
+
+void Tile::showEvent(QShowEvent* e)
+{
+    QWidget::showEvent(e);
+    if (m_expanded) {
+        ensureContent();
     }
 }
 
+void Tile::onExpandButtonClicked()
+{
+    toggleExpanded();
+}
+
+void Tile::loadStyleSheet()
+{
+    // Tile styling is applied once application-wide; per-tile style sheets
+    // would make Qt build a separate style sheet style for every instance
+    Theme::ThemeManager::getInstance().ensureApplied();
+}
+
 void Tile::changeEvent(QEvent* e)
 {
     QWidget::changeEvent(e);
     if (e->type() == QEvent::StyleChange || e->type() == QEvent::PaletteChange) {
+        TileHeaderPainter::clearCache();
         updateUI();
     }
 }
@@ -236,7 +373,123 @@ void Tile::updateCompletionUI()
     if (m_completionCheckBox) {
         QSignalBlocker blocker(m_completionCheckBox);
         m_completionCheckBox->setChecked(m_completed);
+    } else if (m_headerMode == HeaderMode::Painted) {
+        update(headerLayout().completionCheckBox);
+    }
+}
+
+void Tile::setDefaultHeaderMode(HeaderMode mode)
+{
+    defaultHeaderModeRef() = mode;
+}
+
+Tile::HeaderMode Tile::defaultHeaderMode()
+{
+    return defaultHeaderModeRef();
+}
+
+QRect Tile::headerRect() const
+{
+    return QRect(kMargin, kMargin, std::max(0, width() - 2 * kMargin), kButtonSize);
+}
+
+TileHeaderPainter::Layout Tile::headerLayout() const
+{
+    return TileHeaderPainter::layout(headerRect(), kButtonSize, kHeaderSpacing, m_badgeText, this);
+}
+
+void Tile::paintEvent(QPaintEvent* e)
+{
+    QWidget::paintEvent(e);
+    if (m_headerMode != HeaderMode::Painted) return;
+
+    QPainter painter(this);
+    TileHeaderPainter::State state;
+    state.expanded = m_expanded;
+    state.completed = m_completed;
+    state.title = m_title;
+    state.badge = m_badgeText;
+    state.pressedPart = m_pressedPart;
+    TileHeaderPainter::paint(painter, headerLayout(), state, this);
+
+    if (hasFocus()) {
+        // Focus lives on the tile itself in painted mode; mark the expand button
+        QStyleOptionFocusRect option;
+        option.initFrom(this);
+        option.rect = headerLayout().expandButton;
+        style()->drawPrimitive(QStyle::PE_FrameFocusRect, &option, &painter, this);
+    }
+}
+
+void Tile::mousePressEvent(QMouseEvent* e)
+{
+    if (m_headerMode == HeaderMode::Painted && e->button() == Qt::LeftButton) {
+        const auto part = TileHeaderPainter::hitTest(headerLayout(), e->position().toPoint());
+        if (part == TileHeaderPainter::Part::ExpandButton
+            || part == TileHeaderPainter::Part::CompletionCheckBox) {
+            m_pressedPart = part;
+            update(headerRect());
+            e->accept();
+            return;
+        }
+    }
+    QWidget::mousePressEvent(e);
+}
+
+void Tile::mouseReleaseEvent(QMouseEvent* e)
+{
+    if (m_headerMode == HeaderMode::Painted && m_pressedPart != TileHeaderPainter::Part::None) {
+        const auto pressed = m_pressedPart;
+        m_pressedPart = TileHeaderPainter::Part::None;
+        update(headerRect());
+
+        // Like a button: only act when released over the pressed part
+        if (e->button() == Qt::LeftButton
+            && TileHeaderPainter::hitTest(headerLayout(), e->position().toPoint()) == pressed) {
+            if (pressed == TileHeaderPainter::Part::ExpandButton) {
+                onExpandButtonClicked();
+            } else {
+                onCompletionCheckBoxChanged(m_completed ? Qt::Unchecked : Qt::Checked);
+            }
+        }
+        e->accept();
+        return;
+    }
+    QWidget::mouseReleaseEvent(e);
+}
+
+void Tile::keyPressEvent(QKeyEvent* e)
+{
+    if (m_headerMode == HeaderMode::Painted
+        && (e->key() == Qt::Key_Space || e->key() == Qt::Key_Return || e->key() == Qt::Key_Enter)) {
+        onExpandButtonClicked();
+        e->accept();
+        return;
+    }
+    QWidget::keyPressEvent(e);
+}
+
+bool Tile::event(QEvent* e)
+{
+    // Per-part tooltips matching the widget header
+    if (m_headerMode == HeaderMode::Painted && e->type() == QEvent::ToolTip) {
+        auto* helpEvent = static_cast<QHelpEvent*>(e);
+        const auto layout = headerLayout();
+        switch (TileHeaderPainter::hitTest(layout, helpEvent->pos())) {
+        case TileHeaderPainter::Part::ExpandButton:
+            QToolTip::showText(helpEvent->globalPos(), tr("Expand/Collapse"), this, layout.expandButton);
+            return true;
+        case TileHeaderPainter::Part::CompletionCheckBox:
+            QToolTip::showText(helpEvent->globalPos(), tr("Mark as completed"), this, layout.completionCheckBox);
+            return true;
+        default:
+            break;
+        }
+    }
+    if (e->type() == QEvent::FocusIn || e->type() == QEvent::FocusOut) {
+        update(headerRect());
     }
+    return QWidget::event(e);
 }
 
 } // namespace Tiles
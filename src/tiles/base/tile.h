@@ -1,14 +1,16 @@
 #pragma once
 #include <QWidget>
+#include <QString>
+#include "tile_header_painter.h"
 
 // Forward declarations
 class QVBoxLayout;
 class QCheckBox;
 class QPushButton;
 class QLabel;
-class QString;
 class QSize;
 class QEvent;
+class QTimer;
 
 namespace LongView {
 namespace Tiles {
@@ -19,6 +21,9 @@ namespace Tiles {
  * A Tile acts as a visual container that can be expanded/collapsed
  * and marked as completed. This is the foundation for both ItemTile
  * and GroupTile implementations.
+ * 
+ * The header (expand button, completion checkbox, title) is either built
+ * from child widgets or painted directly by the tile, see HeaderMode.
  */
 class Tile : public QWidget {
     Q_OBJECT
@@ -42,6 +47,21 @@ protected:
 public:
     enum class Kind { Item, Group };
     
+    /**
+     * @brief How the header is rendered
+     * 
+     * Widgets: QPushButton/QCheckBox/QLabel children in a header layout.
+     * Painted: drawn in paintEvent() with hit-testing, no child widgets.
+     */
+    enum class HeaderMode { Widgets, Painted };
+    
+    // Header mode used by newly constructed tiles. Defaults to the build
+    // option LONGVIEW_PAINTED_TILE_HEADER, overridable at run time through
+    // the LONGVIEW_TILE_HEADER environment variable ("painted"/"widgets").
+    static void setDefaultHeaderMode(HeaderMode mode);
+    static HeaderMode defaultHeaderMode();
+    HeaderMode headerMode() const { return m_headerMode; }
+    
     explicit Tile(Kind kind, QWidget* parent = nullptr);
     virtual ~Tile() override;
 
@@ -55,21 +75,64 @@ public:
     void setCompleted(bool completed, bool silent = false);
     void toggleExpanded();
     
+    /**
+     * @brief Apply expanded and completed state in one step without emitting signals
+     * 
+     * Used when a tile is (re)bound to externally tracked state, e.g. when a
+     * virtualized group recycles a tile for a different item.
+     */
+    void restoreState(bool expanded, bool completed);
+    
     // Title interface
     void setTitle(const QString& title);
     QString title() const;
     
+    /**
+     * @brief Short right-aligned status text in the header, e.g. progress
+     * @param text Badge text; empty hides the badge
+     */
+    void setBadgeText(const QString& text);
+    QString badgeText() const { return m_badgeText; }
+    
     // Content widget interface
     /**
      * @brief Set the content widget for this tile
      * 
      * The widget will be reparented to this tile and added to the layout.
-     * Any existing content widget will be removed and deleted.
+     * Any existing content widget will be removed and passed to
+     * discardContent(), which deletes it by default.
      * 
-     * @param widget The widget to set as content (can be nullptr)
+     * @param widget The widget to set as content (nullptr removes the content)
      */
     void setContentWidget(QWidget* widget);
     QWidget* contentWidget() const;
+    bool hasContent() const { return m_contentWidget != nullptr; }
+    
+    // Lazy content
+    /**
+     * @brief Build the content via createContent() if it does not exist yet
+     * 
+     * Called automatically the first time the tile is both expanded and visible.
+     */
+    void ensureContent();
+    
+    /**
+     * @brief Tear down content that was built lazily via createContent()
+     * 
+     * Content installed directly with setContentWidget() is left alone.
+     */
+    void releaseContent();
+    
+    /**
+     * @brief Release lazily built content after being collapsed for @p msec
+     * @param msec Delay in milliseconds; negative keeps content forever
+     */
+    void setContentReleaseDelay(int msec);
+    int contentReleaseDelay() const { return m_contentReleaseDelay; }
+    
+    // Default release delay applied to newly constructed tiles (negative = never)
+    static void setDefaultContentReleaseDelay(int msec);
+    static int defaultContentReleaseDelay();
     
     // Virtual interface for subclasses
     virtual void refresh() {} // Optional override for subclasses
@@ -94,11 +157,43 @@ protected:
     virtual void setupUI();
     virtual void updateUI();
     void loadStyleSheet();
+    void showEvent(QShowEvent* e) override;
+    
+    // Painted header support
+    void paintEvent(QPaintEvent* e) override;
+    void mousePressEvent(QMouseEvent* e) override;
+    void mouseReleaseEvent(QMouseEvent* e) override;
+    void keyPressEvent(QKeyEvent* e) override;
+    bool event(QEvent* e) override;
+    QRect headerRect() const;
+    TileHeaderPainter::Layout headerLayout() const;
+    
+    /**
+     * @brief Build the content widget on demand
+     * 
+     * Subclasses with deferrable content override this and call
+     * setContentWidget(). The default implementation builds nothing.
+     */
+    virtual void createContent() {}
+
+    /**
+     * @brief Dispose of a content widget that was removed from the tile
+     *
+     * Subclasses recycling their content override this. The default
+     * implementation hides the widget and deletes it later.
+     */
+    virtual void discardContent(QWidget* widget);
     
     // Core tile state
     Kind m_kind;
+    HeaderMode m_headerMode;
+    QString m_title;
+    QString m_badgeText;
     bool m_expanded = false;  // Default collapsed
     bool m_completed = false;
+    bool m_contentIsLazy = false;  // Content came from createContent() and may be released
+    int m_contentReleaseDelay;
+    QTimer* m_contentReleaseTimer = nullptr;
     
     // UI components
     QVBoxLayout* m_mainLayout = nullptr;
@@ -107,10 +202,15 @@ protected:
     QCheckBox* m_completionCheckBox = nullptr;
     QPushButton* m_expandButton = nullptr;
     QLabel* m_titleLabel = nullptr;
+    QLabel* m_badgeLabel = nullptr;  // Created on first setBadgeText() in widget mode
+    TileHeaderPainter::Part m_pressedPart = TileHeaderPainter::Part::None;
 
 protected slots:
     void onExpandButtonClicked();
     void onCompletionCheckBoxChanged(int state);
+
+private:
+    void scheduleContentRelease();
 };
 
 } // namespace Tiles
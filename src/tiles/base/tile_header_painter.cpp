@@ -0,0 +1,183 @@
+#include "tile_header_painter.h"
+
+#include <QWidget>
+#include <QStyle>
+#include <QStyleOptionButton>
+#include <QPainter>
+#include <QFontMetrics>
+#include <QHash>
+#include <QPoint>
+#include <QTimer>
+#include <algorithm>
+
+namespace LongView {
+namespace Tiles {
+
+namespace {
+    enum class PixmapKind : quint64 { Arrow = 0, CheckBox = 1 };
+
+    struct IconCache {
+        QIcon arrows[2];  // [collapsed, expanded]
+        QHash<quint64, QPixmap> pixmaps;
+    };
+
+    IconCache& iconCache()
+    {
+        static IconCache s_cache;
+        return s_cache;
+    }
+
+    // Pack everything that changes the rendered pixmap into one key
+    quint64 pixmapKey(PixmapKind kind, bool on, bool enabled, const QSize& size, qreal dpr)
+    {
+        const quint64 scaledDpr = static_cast<quint64>(dpr * 100.0) & 0xFFFF;
+        return (static_cast<quint64>(kind) << 62)
+             | (static_cast<quint64>(on) << 61)
+             | (static_cast<quint64>(enabled) << 60)
+             | ((static_cast<quint64>(size.width()) & 0xFFF) << 40)
+             | ((static_cast<quint64>(size.height()) & 0xFFF) << 28)
+             | scaledDpr;
+    }
+}
+
+TileHeaderPainter::Layout TileHeaderPainter::layout(const QRect& headerRect, int buttonSize, int spacing,
+                                                    const QString& badge, const QWidget* widget)
+{
+    Layout result;
+    result.expandButton = QRect(headerRect.left(),
+                                headerRect.top() + (headerRect.height() - buttonSize) / 2,
+                                buttonSize, buttonSize);
+
+    const QStyle* style = widget->style();
+    const int indicatorWidth = style->pixelMetric(QStyle::PM_IndicatorWidth, nullptr, widget);
+    const int indicatorHeight = style->pixelMetric(QStyle::PM_IndicatorHeight, nullptr, widget);
+    result.completionCheckBox = QRect(result.expandButton.right() + 1 + spacing,
+                                      headerRect.top() + (headerRect.height() - indicatorHeight) / 2,
+                                      indicatorWidth, indicatorHeight);
+
+    int titleRight = headerRect.right();
+    if (!badge.isEmpty()) {
+        const int badgeWidth = widget->fontMetrics().horizontalAdvance(badge);
+        result.badge = QRect(headerRect.right() + 1 - badgeWidth, headerRect.top(),
+                             badgeWidth, headerRect.height());
+        titleRight = result.badge.left() - 1 - spacing;
+    }
+
+    const int titleLeft = result.completionCheckBox.right() + 1 + spacing;
+    result.title = QRect(titleLeft, headerRect.top(),
+                         std::max(0, titleRight + 1 - titleLeft), headerRect.height());
+    return result;
+}
+
+void TileHeaderPainter::paint(QPainter& painter, const Layout& layout, const State& state, const QWidget* widget)
+{
+    painter.save();
+
+    // Expand arrow, centered in its button area
+    const int iconExtent = widget->style()->pixelMetric(QStyle::PM_SmallIconSize, nullptr, widget);
+    const QSize iconSize(iconExtent, iconExtent);
+    const QPixmap arrow = arrowPixmap(widget, state.expanded, iconSize);
+    const QRect arrowRect(layout.expandButton.center() - QPoint(iconExtent / 2, iconExtent / 2), iconSize);
+    if (state.pressedPart == Part::ExpandButton) {
+        painter.setOpacity(0.6);
+    }
+    painter.drawPixmap(arrowRect, arrow);
+    painter.setOpacity(1.0);
+
+    // Completion checkbox
+    painter.drawPixmap(layout.completionCheckBox, checkBoxPixmap(widget, state.completed));
+
+    // Title, elided to the remaining width
+    painter.setFont(widget->font());
+    if (!state.title.isEmpty() && layout.title.width() > 0) {
+        painter.setPen(widget->palette().color(QPalette::WindowText));
+        const QString elided = widget->fontMetrics().elidedText(state.title, Qt::ElideRight, layout.title.width());
+        painter.drawText(layout.title, Qt::AlignLeft | Qt::AlignVCenter | Qt::TextSingleLine, elided);
+    }
+
+    // Badge, right-aligned in a muted color
+    if (!state.badge.isEmpty() && !layout.badge.isEmpty()) {
+        painter.setPen(widget->palette().color(QPalette::PlaceholderText));
+        painter.drawText(layout.badge, Qt::AlignRight | Qt::AlignVCenter | Qt::TextSingleLine, state.badge);
+    }
+
+    painter.restore();
+}
+
+TileHeaderPainter::Part TileHeaderPainter::hitTest(const Layout& layout, const QPoint& pos)
+{
+    if (layout.expandButton.contains(pos)) return Part::ExpandButton;
+    if (layout.completionCheckBox.contains(pos)) return Part::CompletionCheckBox;
+    if (layout.title.contains(pos)) return Part::Title;
+    return Part::None;
+}
+
+QIcon TileHeaderPainter::arrowIcon(const QWidget* widget, bool expanded)
+{
+    QIcon& icon = iconCache().arrows[expanded ? 1 : 0];
+    if (icon.isNull()) {
+        icon = widget->style()->standardIcon(expanded ? QStyle::SP_ArrowDown : QStyle::SP_ArrowRight,
+                                             nullptr, widget);
+    }
+    return icon;
+}
+
+QPixmap TileHeaderPainter::arrowPixmap(const QWidget* widget, bool expanded, const QSize& size)
+{
+    const qreal dpr = widget->devicePixelRatioF();
+    const quint64 key = pixmapKey(PixmapKind::Arrow, expanded, widget->isEnabled(), size, dpr);
+
+    auto& pixmaps = iconCache().pixmaps;
+    auto it = pixmaps.constFind(key);
+    if (it != pixmaps.constEnd()) return it.value();
+
+    const QPixmap pixmap = arrowIcon(widget, expanded).pixmap(
+        size, dpr, widget->isEnabled() ? QIcon::Normal : QIcon::Disabled);
+    pixmaps.insert(key, pixmap);
+    return pixmap;
+}
+
+QPixmap TileHeaderPainter::checkBoxPixmap(const QWidget* widget, bool checked)
+{
+    const QStyle* style = widget->style();
+    const QSize size(style->pixelMetric(QStyle::PM_IndicatorWidth, nullptr, widget),
+                     style->pixelMetric(QStyle::PM_IndicatorHeight, nullptr, widget));
+    const qreal dpr = widget->devicePixelRatioF();
+    const quint64 key = pixmapKey(PixmapKind::CheckBox, checked, widget->isEnabled(), size, dpr);
+
+    auto& pixmaps = iconCache().pixmaps;
+    auto it = pixmaps.constFind(key);
+    if (it != pixmaps.constEnd()) return it.value();
+
+    QPixmap pixmap(size * dpr);
+    pixmap.setDevicePixelRatio(dpr);
+    pixmap.fill(Qt::transparent);
+    {
+        QPainter painter(&pixmap);
+        QStyleOptionButton option;
+        option.initFrom(widget);
+        option.rect = QRect(QPoint(0, 0), size);
+        option.state = (widget->isEnabled() ? QStyle::State_Enabled : QStyle::State_None)
+                     | (checked ? QStyle::State_On : QStyle::State_Off);
+        style->drawPrimitive(QStyle::PE_IndicatorCheckBox, &option, &painter, widget);
+    }
+    pixmaps.insert(key, pixmap);
+    return pixmap;
+}
+
+void TileHeaderPainter::clearCache()
+{
+    // Every tile reports the same style/palette change; clear once per event loop pass
+    static bool s_clearedThisPass = false;
+    if (s_clearedThisPass) return;
+    s_clearedThisPass = true;
+    QTimer::singleShot(0, []() { s_clearedThisPass = false; });
+
+    auto& cache = iconCache();
+    cache.arrows[0] = QIcon();
+    cache.arrows[1] = QIcon();
+    cache.pixmaps.clear();
+}
+
+} // namespace Tiles
+} // namespace LongView
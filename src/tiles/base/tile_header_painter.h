@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QIcon>
+#include <QPixmap>
+#include <QRect>
+#include <QString>
+
+// Forward declarations
+class QPainter;
+class QPoint;
+class QWidget;
+
+namespace LongView {
+namespace Tiles {
+
+/**
+ * @brief Paints and hit-tests a tile header without child widgets
+ *
+ * Draws the expand arrow, completion checkbox and title directly onto the
+ * tile, so a painted-header Tile needs no header QWidget, layout, button,
+ * checkbox or label. Arrow and checkbox pixmaps are rendered once per
+ * state and device pixel ratio and shared by all tiles until the style
+ * changes.
+ */
+class TileHeaderPainter {
+public:
+    enum class Part { None, ExpandButton, CompletionCheckBox, Title };
+
+    struct Layout {
+        QRect expandButton;
+        QRect completionCheckBox;
+        QRect title;
+        QRect badge;  // Empty when there is no badge text
+    };
+
+    struct State {
+        bool expanded = false;
+        bool completed = false;
+        QString title;
+        QString badge;
+        Part pressedPart = Part::None;
+    };
+
+    /**
+     * @brief Split a header rect into expand button, checkbox, title and badge parts
+     * @param headerRect Header area in tile coordinates
+     * @param buttonSize Edge length of the expand button
+     * @param spacing Horizontal spacing between parts
+     * @param badge Right-aligned badge text (may be empty)
+     * @param widget Widget whose style metrics are used
+     */
+    static Layout layout(const QRect& headerRect, int buttonSize, int spacing,
+                         const QString& badge, const QWidget* widget);
+
+    static void paint(QPainter& painter, const Layout& layout, const State& state, const QWidget* widget);
+
+    static Part hitTest(const Layout& layout, const QPoint& pos);
+
+    // Shared icon cache (also used by widget headers)
+    static QIcon arrowIcon(const QWidget* widget, bool expanded);
+    static QPixmap arrowPixmap(const QWidget* widget, bool expanded, const QSize& size);
+    static QPixmap checkBoxPixmap(const QWidget* widget, bool checked);
+
+    /**
+     * @brief Drop all cached icons and pixmaps, e.g. after a style change
+     *
+     * Repeated calls within one event loop pass only clear once.
+     */
+    static void clearCache();
+};
+
+} // namespace Tiles
+} // namespace LongView
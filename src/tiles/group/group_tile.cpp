@@ -1,9 +1,12 @@
 #include "group_tile.h"
 #include "../item/item_tile.h"
+#include "virtual_item_list.h"
+#include <QDebug>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QSignalBlocker>
+#include <QSpacerItem>
 #include <QString>
 #include <algorithm>
 #include <optional>
@@ -17,7 +20,6 @@ namespace Tiles {
 namespace {
     constexpr int kItemSpacing = 8;
     constexpr int kGroupMargin = 12;
-    constexpr int kPlaceholderPadding = 20;
     
     // Utility function to safely convert optional string to QString
     static inline QString optName(const std::optional<std::string>& n) {
@@ -28,6 +30,7 @@ namespace {
 GroupTile::GroupTile(const Config::Group& group, QWidget* parent)
     : Tile(Kind::Group, parent)
     , m_group(group)
+    , m_overscan(VirtualItemList::kDefaultOverscan)
     , m_updatingCompletion(false)
 {
     const QString title = m_group.name ? QString::fromStdString(*m_group.name) : tr("Group");
@@ -38,6 +41,11 @@ GroupTile::GroupTile(const Config::Group& group, QWidget* parent)
     
     buildContent();
     
+    // Large groups only materialize the item tiles that are on screen
+    if (m_group.items.size() >= kAutoVirtualizeThreshold) {
+        createVirtualList();
+    }
+    
     // Populate items from config AFTER building content
     populateFromConfig();
     
@@ -71,15 +79,8 @@ GroupTile::GroupTile(const Config::Group& group, QWidget* parent)
 
 void GroupTile::buildContent()
 {
-    // Create scroll area for items container
-    auto* scrollArea = new QScrollArea(this);
-    scrollArea->setWidgetResizable(true);
-    scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
-    scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
-    scrollArea->setFrameShape(QFrame::NoFrame);
-    
     // Create container widget for items
-    auto* container = new QWidget(scrollArea);
+    auto* container = new QWidget(this);
     m_itemsLayout = new QVBoxLayout(container);
     m_itemsLayout->setContentsMargins(kGroupMargin, kGroupMargin, kGroupMargin, kGroupMargin);
     m_itemsLayout->setSpacing(kItemSpacing);
@@ -102,14 +103,29 @@ void GroupTile::buildContent()
     // Add placeholder for items
     m_itemsPlaceholder = new QLabel(tr("No items added yet"));
     m_itemsPlaceholder->setAlignment(Qt::AlignCenter);
-    m_itemsPlaceholder->setStyleSheet(QString("color: #888; padding: %1px;").arg(kPlaceholderPadding));
+    m_itemsPlaceholder->setObjectName("LongViewPlaceholder"); // Styled by the theme QSS
     m_itemsLayout->addWidget(m_itemsPlaceholder);
     
-    // Set the container as the scroll area's widget
-    scrollArea->setWidget(container);
-    
-    // Set the scroll area as the content widget
-    setContentWidget(scrollArea);
+    // Groups grow with their items and scroll as part of the dashboard;
+    // only a configured max_height gives them their own nested scroll area
+    if (m_group.max_height) {
+        auto* scrollArea = new QScrollArea(this);
+        m_scrollArea = scrollArea;
+        scrollArea->setWidgetResizable(true);
+        scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+        scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+        scrollArea->setFrameShape(QFrame::NoFrame);
+        scrollArea->setMaximumHeight(*m_group.max_height);
+        scrollArea->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::MinimumExpanding);
+        
+        // Set the container as the scroll area's widget
+        scrollArea->setWidget(container);
+        
+        // Set the scroll area as the content widget
+        setContentWidget(scrollArea);
+    } else {
+        setContentWidget(container);
+    }
     
     // Critical fix: ensure content container visibility is correctly set
     container->setVisible(true);
@@ -117,7 +133,6 @@ void GroupTile::buildContent()
     // Set size policies for better height adaptation
     // Use MinimumExpanding for height to prevent compression
     container->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::MinimumExpanding);
-    scrollArea->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::MinimumExpanding);
     this->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::MinimumExpanding);
     
     // Set tooltip with group information
@@ -146,18 +161,28 @@ bool GroupTile::addItemTile(ItemTile* itemTile)
 {
     if (!itemTile) return false;
     
+    // Virtualized groups own their rows as data, not as externally created tiles
+    if (m_virtualList) {
+        qWarning() << "GroupTile::addItemTile is not supported in virtualized mode";
+        return false;
+    }
+    
     // Prevent duplicate addition
-    if (std::find(m_itemTiles.begin(), m_itemTiles.end(), itemTile) != m_itemTiles.end()) {
+    if (m_itemTileSlots.count(itemTile) > 0) {
         return false;
     }
     
     // Hide placeholder when adding first item
-    if (m_itemTiles.empty()) {
+    if (itemCount() == 0) {
         m_itemsPlaceholder->setVisible(false);
     }
     
     // Take ownership of the item tile
+    m_itemTileSlots.emplace(itemTile, m_itemTiles.size());
     m_itemTiles.push_back(itemTile);
+    if (itemTile->isCompleted()) {
+        m_completedItemTiles.insert(itemTile);
+    }
     m_itemsLayout->addWidget(itemTile); // addWidget automatically sets parent
     
     // Align item tile visibility with group expansion state for better UX
@@ -172,6 +197,7 @@ bool GroupTile::addItemTile(ItemTile* itemTile)
     // Update header info
     updateHeaderCount();
     
+    emit itemTileAttached(itemTile);
     return true;
 }
 
@@ -184,13 +210,14 @@ bool GroupTile::addItemTile(ItemTile* itemTile)
  */
 bool GroupTile::removeItemTile(ItemTile* itemTile)
 {
-    auto it = std::find(m_itemTiles.begin(), m_itemTiles.end(), itemTile);
-    if (it == m_itemTiles.end()) return false;
+    if (!eraseItemTileSlot(itemTile)) return false;
     
     disconnectItemTile(itemTile);
-    m_itemsLayout->removeWidget(itemTile);
+    // Deletion is deferred; loads in flight must not wait for it
+    itemTile->cancelLoads();
     itemTile->deleteLater();
-    m_itemTiles.erase(it);
+    m_completedItemTiles.erase(itemTile);
+    emit itemTileDetached(itemTile);
     
     // Update group completion state
     updateGroupCompletionState();
@@ -199,7 +226,7 @@ bool GroupTile::removeItemTile(ItemTile* itemTile)
     updateHeaderCount();
     
     // Add placeholder back if no items
-    if (m_itemTiles.empty()) {
+    if (itemCount() == 0) {
         m_itemsPlaceholder->setVisible(true);
     }
     
@@ -213,13 +240,29 @@ bool GroupTile::removeItemTile(ItemTile* itemTile)
  */
 void GroupTile::clearItemTiles()
 {
-    // Disconnect all item tiles first
+    // Item slots are the last layout items; taking them from the back is
+    // O(1) each, where removeWidget() would scan the layout per tile
+    const int firstItemIndex = firstItemLayoutIndex();
+    for (size_t i = m_itemTiles.size(); i-- > 0;) {
+        delete m_itemsLayout->takeAt(firstItemIndex + static_cast<int>(i));
+    }
+    
+    // Disconnect all item tiles first so their destruction does not call back
     for (auto* itemTile : m_itemTiles) {
+        if (!itemTile) continue;
         disconnectItemTile(itemTile);
-        m_itemsLayout->removeWidget(itemTile);
+        itemTile->cancelLoads();
         itemTile->deleteLater();
+        emit itemTileDetached(itemTile);
     }
     m_itemTiles.clear();
+    m_itemTileSlots.clear();
+    m_itemTileHoles = 0;
+    m_completedItemTiles.clear();
+    
+    if (m_virtualList) {
+        m_virtualList->clear();
+    }
     
     // Update group completion state
     updateGroupCompletionState();
@@ -234,7 +277,17 @@ void GroupTile::clearItemTiles()
 void GroupTile::populateFromConfig()
 {
     clearItemTiles();
+    
+    if (m_virtualList) {
+        m_virtualList->setItems(m_group.items);
+        m_itemsPlaceholder->setVisible(m_group.items.empty());
+        updateGroupCompletionState();
+        updateHeaderCount();
+        return;
+    }
+    
     m_itemTiles.reserve(m_group.items.size());
+    m_itemTileSlots.reserve(m_group.items.size());
     for (const auto& item : m_group.items) {
         auto* tile = new ItemTile(item, this);
         addItemTile(tile);
@@ -244,12 +297,90 @@ void GroupTile::populateFromConfig()
     updateHeaderCount();
 }
 
+void GroupTile::applyConfig(const Config::Group& group, const Config::ListDiff& itemDiff)
+{
+    m_group = group;
+    if (itemDiff.isEmpty()) return;
+    
+    // The diff is relative to the config; tiles added or removed by hand break that
+    const size_t kept = m_group.items.size() - itemDiff.added.size();
+    if (itemCount() != kept + itemDiff.removed.size()) {
+        populateFromConfig();
+        if (isExpanded()) {
+            expandAllItems();
+        }
+        return;
+    }
+    
+    if (m_virtualList) {
+        m_virtualList->applyDiff(m_group.items, itemDiff, isExpanded());
+        m_itemsPlaceholder->setVisible(m_group.items.empty());
+        updateGroupCompletionState();
+        updateHeaderCount();
+        return;
+    }
+    
+    BatchUpdate batch(this);
+    
+    compactItemTiles();
+    const std::vector<ItemTile*> oldTiles = m_itemTiles;
+    for (int index : itemDiff.removed) {
+        removeItemTile(oldTiles[index]);
+    }
+    // Layout positions below assume no hole spacers
+    compactItemTiles();
+    
+    // Moved tiles leave the layout and are put back at their new position
+    // below; the tiles that kept their relative order stay where they are
+    for (int index : itemDiff.moved) {
+        m_itemsLayout->removeWidget(oldTiles[itemDiff.sources[index]]);
+    }
+    
+    const int firstItemIndex = firstItemLayoutIndex();
+    m_itemTiles.clear();
+    m_itemTileSlots.clear();
+    m_itemTileHoles = 0;
+    for (size_t i = 0; i < m_group.items.size(); ++i) {
+        const int index = static_cast<int>(i);
+        const int source = itemDiff.sources[i];
+        ItemTile* itemTile = nullptr;
+        if (source >= 0) {
+            itemTile = oldTiles[source];
+            if (itemDiff.isMoved(index)) {
+                m_itemsLayout->insertWidget(firstItemIndex + index, itemTile);
+            }
+            if (itemDiff.isModified(index)) {
+                itemTile->bind(m_group.items[i]);
+                emit itemTileAttached(itemTile);
+            }
+        } else {
+            // New items follow the group's expansion state, like the initial ones
+            itemTile = new ItemTile(m_group.items[i], this);
+            itemTile->restoreState(isExpanded(), false);
+            m_itemsLayout->insertWidget(firstItemIndex + index, itemTile);
+            itemTile->setVisible(isExpanded());
+            setupItemTileConnections(itemTile);
+            emit itemTileAttached(itemTile);
+        }
+        m_itemTileSlots.emplace(itemTile, m_itemTiles.size());
+        m_itemTiles.push_back(itemTile);
+    }
+    
+    m_itemsPlaceholder->setVisible(m_itemTiles.empty());
+    updateGroupCompletionState();
+    updateHeaderCount();
+}
+
 void GroupTile::refresh()
 {
     // Refresh all child item tiles
+    compactItemTiles();
     for (auto* itemTile : m_itemTiles) {
         itemTile->refresh();
     }
+    if (m_virtualList) {
+        m_virtualList->refreshLiveTiles();
+    }
     
     // Update group completion state
     updateGroupCompletionState();
@@ -266,15 +397,15 @@ void GroupTile::setupItemTileConnections(ItemTile* itemTile)
     
     // Listen for destroyed signal to automatically remove from m_itemTiles
     // This prevents dangling pointers if external code manually deletes an ItemTile
+    // Only the pointer value is used: the ItemTile part is already destroyed here
     connect(itemTile, &QObject::destroyed, this, [this](QObject* obj){
         auto* tile = static_cast<ItemTile*>(obj);
-        auto it = std::find(m_itemTiles.begin(), m_itemTiles.end(), tile);
-        if (it != m_itemTiles.end()) {
-            m_itemTiles.erase(it);
+        if (eraseItemTileSlot(tile)) {
+            m_completedItemTiles.erase(tile);
             updateHeaderCount();
             updateGroupCompletionState();
             // Show placeholder if this was the last item
-            if (m_itemTiles.empty() && m_itemsPlaceholder) {
+            if (itemCount() == 0 && m_itemsPlaceholder) {
                 m_itemsPlaceholder->setVisible(true);
             }
         }
@@ -291,13 +422,25 @@ void GroupTile::disconnectItemTile(ItemTile* itemTile)
 void GroupTile::onItemTileExpandedChanged(bool expanded)
 {
     Q_UNUSED(expanded);
+    // Inside a batch, changes are aggregated and handled once at the end
+    if (isBatchUpdating()) {
+        ++m_batchExpandedChanges;
+        return;
+    }
     // Update expand button state based on children
     updateExpandButtonState();
 }
 
 void GroupTile::onItemTileCompletedChanged(bool completed)
 {
-    Q_UNUSED(completed);
+    // Keep the completed set in sync; sender is the ItemTile (eager mode)
+    if (auto* itemTile = qobject_cast<ItemTile*>(sender())) {
+        if (completed) {
+            m_completedItemTiles.insert(itemTile);
+        } else {
+            m_completedItemTiles.erase(itemTile);
+        }
+    }
     // Update group completion state based on children
     // This is called when any child item's completion state changes
     updateGroupCompletionState();
@@ -305,10 +448,12 @@ void GroupTile::onItemTileCompletedChanged(bool completed)
 
 void GroupTile::updateGroupCompletionState()
 {
+    updateProgress();
+    
     // Prevent re-entrant calls during completion updates
     if (m_updatingCompletion) return;
     
-    if (m_itemTiles.empty()) {
+    if (itemCount() == 0) {
         // Empty group is always incomplete
         if (isCompleted() != false) {
             m_updatingCompletion = true;
@@ -318,14 +463,8 @@ void GroupTile::updateGroupCompletionState()
         return;
     }
     
-    // Check if all items are completed
-    bool allCompleted = true;
-    for (const auto* itemTile : m_itemTiles) {
-        if (!itemTile->isCompleted()) {
-            allCompleted = false;
-            break;
-        }
-    }
+    // All items are completed when the incrementally kept counter says so
+    const bool allCompleted = completedCount() == totalCount();
     
     // Only update if state is different to avoid unnecessary signals
     if (isCompleted() != allCompleted) {
@@ -342,22 +481,80 @@ void GroupTile::syncCompletionToItems(bool completed)
     
     m_updatingCompletion = true;
     
-    // Sync completion state to all child items
+    int changed = 0;
+    if (m_virtualList) {
+        changed += m_virtualList->setAllCompleted(completed);
+    }
+    
+    // Sync completion state to all child items in a single pass
+    compactItemTiles();
     for (auto* itemTile : m_itemTiles) {
-        // Use silent mode to prevent triggering item's completionChanged signal
-        // which would call updateGroupCompletionState() again
+        // Apply without emitting the item's completedChanged signal, which
+        // would call updateGroupCompletionState() again, and refresh its UI
         if (itemTile->isCompleted() != completed) {
-            itemTile->setCompleted(completed, true);
+            itemTile->restoreState(itemTile->isExpanded(), completed);
+            ++changed;
         }
     }
+    if (completed) {
+        m_completedItemTiles.insert(m_itemTiles.begin(), m_itemTiles.end());
+    } else {
+        m_completedItemTiles.clear();
+    }
+    
+    m_updatingCompletion = false;
     
-    // Force UI update for all child items to immediately reflect the changes
+    if (changed > 0) {
+        emit itemsCompletedChanged(changed);
+    }
+    updateProgress();
+}
+
+int GroupTile::completedCount() const
+{
+    return m_virtualList ? m_virtualList->completedCount()
+                         : static_cast<int>(m_completedItemTiles.size());
+}
+
+int GroupTile::markItemsCompleted(const std::function<bool(const Config::Item&)>& predicate, bool completed)
+{
+    if (!predicate) return 0;
+    
+    int changed = 0;
+    if (m_virtualList) {
+        changed += m_virtualList->setCompletedWhere(predicate, completed);
+    }
+    compactItemTiles();
     for (auto* itemTile : m_itemTiles) {
-        // Update the completion checkbox UI state without triggering signals
-        itemTile->updateCompletionUI();
+        if (itemTile->isCompleted() != completed && predicate(itemTile->item())) {
+            itemTile->restoreState(itemTile->isExpanded(), completed);
+            if (completed) {
+                m_completedItemTiles.insert(itemTile);
+            } else {
+                m_completedItemTiles.erase(itemTile);
+            }
+            ++changed;
+        }
     }
     
-    m_updatingCompletion = false;
+    // One group-level update (and progressChanged) for the whole batch
+    if (changed > 0) {
+        emit itemsCompletedChanged(changed);
+        updateGroupCompletionState();
+    }
+    return changed;
+}
+
+void GroupTile::updateProgress()
+{
+    const int completed = completedCount();
+    const int total = totalCount();
+    if (completed == m_lastProgressCompleted && total == m_lastProgressTotal) return;
+    
+    m_lastProgressCompleted = completed;
+    m_lastProgressTotal = total;
+    setBadgeText(tr("%1 / %2 done").arg(completed).arg(total));
+    emit progressChanged(completed, total);
 }
 
 void GroupTile::updateExpandButtonState()
@@ -371,7 +568,7 @@ void GroupTile::updateHeaderCount()
 {
     if (!m_headerInfo) return;
     
-    const size_t currentCount = m_itemTiles.size();
+    const size_t currentCount = itemCount();
     
     // Skip update if item count hasn't changed (micro-optimization)
     if (currentCount == m_lastItemCount) return;
@@ -391,9 +588,17 @@ void GroupTile::updateHeaderCount()
 
 QSize GroupTile::sizeHint() const
 {
-    // With QScrollArea, we can use a fixed height for the group tile
-    // The content will scroll internally if needed
-    return QSize(Tile::kDefaultWidth, Tile::kDefaultHeight);
+    // Full content height; a nested scroll area is already capped by max_height
+    const int height = m_mainLayout ? m_mainLayout->sizeHint().height() : Tile::kDefaultHeight;
+    return QSize(Tile::kDefaultWidth, std::max(height, Tile::kMinHeight));
+}
+
+void GroupTile::updateVisibleRegion(const QWidget* viewport)
+{
+    // Nested scroll areas track their own viewport
+    if (m_virtualList && !m_scrollArea) {
+        m_virtualList->updateVisibleRect(viewport);
+    }
 }
 
 QSize GroupTile::minimumSizeHint() const
@@ -406,18 +611,229 @@ void GroupTile::expandAllItems()
 {
     // Expand all child ItemTiles only
     // Group expansion state is managed externally via expandedChanged signal
-    for (auto* itemTile : m_itemTiles) {
-        itemTile->setExpanded(true);
-    }
+    setAllItemsExpanded(true);
 }
 
 void GroupTile::collapseAllItems()
 {
     // Collapse all child ItemTiles only
     // Group expansion state is managed externally via expandedChanged signal
+    setAllItemsExpanded(false);
+}
+
+void GroupTile::setAllItemsExpanded(bool expanded)
+{
+    BatchUpdate batch(this);
+    
+    if (m_virtualList) {
+        m_batchExpandedChanges += m_virtualList->setAllExpanded(expanded);
+    }
+    compactItemTiles();
     for (auto* itemTile : m_itemTiles) {
-        itemTile->setExpanded(false);
+        if (itemTile->isExpanded() != expanded) {
+            // Apply without per-tile signals; the batch reports the aggregate
+            itemTile->restoreState(expanded, itemTile->isCompleted());
+            ++m_batchExpandedChanges;
+        }
+    }
+}
+
+void GroupTile::beginBatchUpdate()
+{
+    if (m_batchDepth++ > 0) return;
+    
+    m_batchExpandedChanges = 0;
+    setUpdatesEnabled(false);
+    if (m_itemsLayout) {
+        m_itemsLayout->setEnabled(false);
+    }
+}
+
+void GroupTile::endBatchUpdate()
+{
+    Q_ASSERT(m_batchDepth > 0);
+    if (--m_batchDepth > 0) return;
+    
+    // Single relayout for everything changed in the batch
+    if (m_itemsLayout) {
+        m_itemsLayout->setEnabled(true);
+        m_itemsLayout->activate();
+    }
+    setUpdatesEnabled(true);
+    
+    const int changed = m_batchExpandedChanges;
+    m_batchExpandedChanges = 0;
+    if (changed > 0) {
+        updateExpandButtonState();
+        emit itemsExpandedChanged(changed);
+    }
+}
+
+size_t GroupTile::itemCount() const
+{
+    return m_virtualList ? static_cast<size_t>(m_virtualList->count())
+                         : m_itemTiles.size() - m_itemTileHoles;
+}
+
+const std::vector<ItemTile*>& GroupTile::itemTiles() const
+{
+    compactItemTiles();
+    return m_itemTiles;
+}
+
+int GroupTile::indexOfItemTile(const ItemTile* itemTile) const
+{
+    compactItemTiles();
+    auto it = m_itemTileSlots.find(itemTile);
+    return it != m_itemTileSlots.end() ? static_cast<int>(it->second) : -1;
+}
+
+int GroupTile::firstItemLayoutIndex() const
+{
+    // Item tiles follow the header and the placeholder
+    return m_itemsLayout->indexOf(m_itemsPlaceholder) + 1;
+}
+
+bool GroupTile::eraseItemTileSlot(const ItemTile* itemTile)
+{
+    auto it = m_itemTileSlots.find(itemTile);
+    if (it == m_itemTileSlots.end()) return false;
+    
+    // The hole gets an empty spacer in the layout, so layout positions keep
+    // matching slots and the tile is taken out by index, not by a scan. A
+    // tile being destroyed may already have been dropped by the layout.
+    const int layoutIndex = firstItemLayoutIndex() + static_cast<int>(it->second);
+    QLayoutItem* layoutItem = m_itemsLayout->itemAt(layoutIndex);
+    if (layoutItem && layoutItem->widget() == itemTile) {
+        delete m_itemsLayout->takeAt(layoutIndex);
+    }
+    m_itemsLayout->insertItem(layoutIndex, new QSpacerItem(0, 0));
+    
+    m_itemTiles[it->second] = nullptr;
+    m_itemTileSlots.erase(it);
+    ++m_itemTileHoles;
+    
+    // Compact once holes dominate; keeps removal O(1) amortized
+    if (m_itemTileHoles * 2 > m_itemTiles.size()) {
+        compactItemTiles();
     }
+    return true;
+}
+
+void GroupTile::compactItemTiles() const
+{
+    if (m_itemTileHoles == 0) return;
+    
+    // Take all item slots off the end of the layout and put back the live
+    // tiles, dropping the spacers that stood in for holes: one O(n) pass
+    const int firstItemIndex = firstItemLayoutIndex();
+    std::vector<QLayoutItem*> layoutItems(m_itemTiles.size());
+    for (size_t i = m_itemTiles.size(); i-- > 0;) {
+        layoutItems[i] = m_itemsLayout->takeAt(firstItemIndex + static_cast<int>(i));
+    }
+    
+    size_t live = 0;
+    for (size_t i = 0; i < m_itemTiles.size(); ++i) {
+        if (!m_itemTiles[i]) {
+            delete layoutItems[i];
+            continue;
+        }
+        m_itemsLayout->addItem(layoutItems[i]);
+        m_itemTiles[live] = m_itemTiles[i];
+        m_itemTileSlots[m_itemTiles[live]] = live;
+        ++live;
+    }
+    m_itemTiles.resize(live);
+    m_itemTileHoles = 0;
+}
+
+bool GroupTile::moveItemTile(ItemTile* itemTile, size_t newIndex)
+{
+    const int from = indexOfItemTile(itemTile);
+    if (from < 0) return false;
+    return moveItem(static_cast<size_t>(from), newIndex);
+}
+
+bool GroupTile::moveItem(size_t from, size_t to)
+{
+    if (m_virtualList) {
+        return m_virtualList->moveItem(static_cast<int>(from), static_cast<int>(to));
+    }
+    
+    compactItemTiles();
+    if (from >= m_itemTiles.size() || to >= m_itemTiles.size()) return false;
+    if (from == to) return true;
+    
+    // Shift only the range between the two positions and re-index it
+    const size_t first = std::min(from, to);
+    const size_t last = std::max(from, to);
+    if (from < to) {
+        std::rotate(m_itemTiles.begin() + from, m_itemTiles.begin() + from + 1, m_itemTiles.begin() + to + 1);
+    } else {
+        std::rotate(m_itemTiles.begin() + to, m_itemTiles.begin() + from, m_itemTiles.begin() + from + 1);
+    }
+    for (size_t i = first; i <= last; ++i) {
+        m_itemTileSlots[m_itemTiles[i]] = i;
+    }
+    
+    // Layout positions match slots after compaction
+    const int firstItemIndex = firstItemLayoutIndex();
+    QLayoutItem* layoutItem = m_itemsLayout->takeAt(firstItemIndex + static_cast<int>(from));
+    m_itemsLayout->insertItem(firstItemIndex + static_cast<int>(to), layoutItem);
+    return true;
+}
+
+void GroupTile::setVirtualized(bool virtualized)
+{
+    if (isVirtualized() == virtualized) return;
+    
+    clearItemTiles();
+    
+    if (virtualized) {
+        createVirtualList();
+    } else {
+        m_itemsLayout->removeWidget(m_virtualList);
+        m_virtualList->deleteLater();
+        m_virtualList = nullptr;
+    }
+    
+    populateFromConfig();
+    
+    // New tiles follow the group's expansion state
+    if (isExpanded()) {
+        expandAllItems();
+    }
+}
+
+void GroupTile::createVirtualList()
+{
+    m_virtualList = new VirtualItemList;
+    m_virtualList->setOverscan(m_overscan);
+    m_virtualList->setSpacing(kItemSpacing);
+    m_itemsLayout->addWidget(m_virtualList); // addWidget automatically sets parent
+    if (m_scrollArea) {
+        m_virtualList->attachToScrollArea(m_scrollArea);
+    }
+    
+    connect(m_virtualList, &VirtualItemList::itemExpandedChanged,
+            this, [this](int, bool expanded) { onItemTileExpandedChanged(expanded); });
+    connect(m_virtualList, &VirtualItemList::itemCompletedChanged,
+            this, [this](int, bool) { updateGroupCompletionState(); });
+    connect(m_virtualList, &VirtualItemList::tileAttached, this, &GroupTile::itemTileAttached);
+    connect(m_virtualList, &VirtualItemList::tileDetached, this, &GroupTile::itemTileDetached);
+}
+
+void GroupTile::setOverscan(int pixels)
+{
+    m_overscan = pixels;
+    if (m_virtualList) {
+        m_virtualList->setOverscan(pixels);
+    }
+}
+
+int GroupTile::overscan() const
+{
+    return m_overscan;
 }
 
 } // namespace Tiles
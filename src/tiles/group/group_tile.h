@@ -2,27 +2,43 @@
 
 #include "../base/tile.h"
 #include "../../config/config.h"
+#include "../../config/config_diff.h"
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // Forward declarations
 class QVBoxLayout;
 class QLabel;
+class QScrollArea;
 
 namespace LongView {
 namespace Tiles {
 
 class ItemTile;
+class VirtualItemList;
 
 /**
  * @brief GroupTile represents a group of items in the LongView application
  * 
  * Manages a collection of ItemTiles with group-level functionality.
  * Takes ownership of added ItemTiles and deletes them when removed.
+ * 
+ * Large groups run in virtualized mode: items are kept as data in a
+ * VirtualItemList and only the tiles intersecting the viewport exist as
+ * widgets. In that mode itemTiles() is empty and addItemTile() is rejected.
  */
 class GroupTile final : public Tile {
     Q_OBJECT
+    
+    Q_PROPERTY(int completedCount READ completedCount NOTIFY progressChanged)
+    Q_PROPERTY(int totalCount READ totalCount NOTIFY progressChanged)
 
 public:
+    // Groups with at least this many items start out virtualized
+    static constexpr size_t kAutoVirtualizeThreshold = 100;
+
     explicit GroupTile(const Config::Group& group, QWidget* parent = nullptr);
     ~GroupTile() override = default;
 
@@ -32,36 +48,170 @@ public:
     void clearItemTiles();
     void populateFromConfig();
     
+    /**
+     * @brief Take over an edited version of this group's config
+     * 
+     * Only the items named by @p itemDiff are touched: removed tiles are
+     * deleted, added ones created, moved ones repositioned and modified ones
+     * rebound. All other tiles keep their state and content. Both modes.
+     * 
+     * @param group The same group (name and max_height) with edited items
+     * @param itemDiff Difference from the current items to @p group's items
+     */
+    void applyConfig(const Config::Group& group, const Config::ListDiff& itemDiff);
+    
+    // Reordering
+    /**
+     * @brief Move an ItemTile to a new position (eager mode)
+     * @return false if the tile is not in this group
+     */
+    bool moveItemTile(ItemTile* itemTile, size_t newIndex);
+    
+    /**
+     * @brief Move the item at @p from to position @p to (both modes)
+     */
+    bool moveItem(size_t from, size_t to);
+    
+    /**
+     * @brief Position of an ItemTile within this group, or -1
+     */
+    int indexOfItemTile(const ItemTile* itemTile) const;
+    
     // New methods for recursive expansion control
     void expandAllItems();
     void collapseAllItems();
+    void setAllItemsExpanded(bool expanded);
+    
+    /**
+     * @brief RAII scope batching item state changes on a GroupTile
+     * 
+     * While any batch is open, painting and the items layout are suspended
+     * and item expansion changes are counted instead of handled one by one.
+     * Closing the outermost batch performs a single relayout and emits
+     * itemsExpandedChanged() once. Batches may nest.
+     */
+    class BatchUpdate {
+    public:
+        explicit BatchUpdate(GroupTile* group) : m_group(group) { m_group->beginBatchUpdate(); }
+        ~BatchUpdate() { m_group->endBatchUpdate(); }
+        BatchUpdate(const BatchUpdate&) = delete;
+        BatchUpdate& operator=(const BatchUpdate&) = delete;
+    private:
+        GroupTile* m_group;
+    };
+    void beginBatchUpdate();
+    void endBatchUpdate();
+    bool isBatchUpdating() const { return m_batchDepth > 0; }
     
     const Config::Group& group() const { return m_group; }
-    const std::vector<ItemTile*>& itemTiles() const { return m_itemTiles; }
+    const std::vector<ItemTile*>& itemTiles() const;
+    size_t itemCount() const;
+    
+    // Progress, maintained incrementally from child signals
+    int completedCount() const;
+    int totalCount() const { return static_cast<int>(itemCount()); }
+    
+    /**
+     * @brief Set completion on all items matching @p predicate in one step
+     * 
+     * Items are updated without emitting their own completedChanged();
+     * the group emits a single itemsCompletedChanged() and progressChanged()
+     * afterwards.
+     * 
+     * @return Number of items whose completion state changed
+     */
+    int markItemsCompleted(const std::function<bool(const Config::Item&)>& predicate, bool completed = true);
+    
+    // Virtualization
+    /**
+     * @brief Switch between eager and viewport-virtualized item tiles
+     * 
+     * Rebuilds the items from the group config; per-item state is reset.
+     */
+    void setVirtualized(bool virtualized);
+    bool isVirtualized() const { return m_virtualList != nullptr; }
+    void setOverscan(int pixels);
+    int overscan() const;
+    VirtualItemList* virtualItemList() const { return m_virtualList; }
+    
+    /**
+     * @brief Whether items scroll inside the group (Config::Group::max_height set)
+     */
+    bool hasNestedScrolling() const { return m_scrollArea != nullptr; }
+    
+    /**
+     * @brief Let a virtualized group know which part of it an outer viewport shows
+     * 
+     * Called by the dashboard's scroll surface for groups without nested scrolling.
+     */
+    void updateVisibleRegion(const QWidget* viewport);
     
     // Override Tile methods
     void refresh() override;
     QSize sizeHint() const override;
     QSize minimumSizeHint() const override;
 
+signals:
+    /**
+     * @brief Aggregated notification for item expansion changes made in a batch
+     * 
+     * Items changed inside a batch do not emit their own expandedChanged(),
+     * so per-item listeners have to re-check the group's items here.
+     * @param changedCount Number of items whose expanded state changed
+     */
+    void itemsExpandedChanged(int changedCount);
+    
+    /**
+     * @brief Aggregated notification for item completion set by the group
+     * 
+     * Emitted by markItemsCompleted() and when the group's own completion is
+     * pushed down to its items; those items emit no completedChanged().
+     * @param changedCount Number of items whose completed state changed
+     */
+    void itemsCompletedChanged(int changedCount);
+    void progressChanged(int completed, int total);
+    
+    /**
+     * @brief An ItemTile started or stopped representing an item of this group
+     * 
+     * Covers added/removed tiles in eager mode and tiles bound to or recycled
+     * from rows in virtualized mode.
+     */
+    void itemTileAttached(LongView::Tiles::ItemTile* itemTile);
+    void itemTileDetached(LongView::Tiles::ItemTile* itemTile);
+
 private slots:
     void onItemTileExpandedChanged(bool expanded);
     void onItemTileCompletedChanged(bool completed);
 
 private:
     void buildContent();
+    void createVirtualList();
     void setupItemTileConnections(ItemTile* itemTile);
+    int firstItemLayoutIndex() const;
+    bool eraseItemTileSlot(const ItemTile* itemTile);
+    void compactItemTiles() const;
     void disconnectItemTile(ItemTile* itemTile);
     void updateExpandButtonState();
     void updateHeaderCount();
     void updateGroupCompletionState();
+    void updateProgress();
     
     // Updated method signature - removed fromUser parameter
     void syncCompletionToItems(bool completed);
 
-    const Config::Group m_group;
-    std::vector<ItemTile*> m_itemTiles;
+    Config::Group m_group;
+    // Item tiles in display order. Removal leaves a nullptr hole (and an
+    // empty spacer at the same position in m_itemsLayout) that is compacted
+    // away lazily, so add/remove/destroy are O(1) amortized.
+    mutable std::vector<ItemTile*> m_itemTiles;
+    mutable std::unordered_map<const ItemTile*, size_t> m_itemTileSlots;  // Tile -> index in m_itemTiles
+    mutable size_t m_itemTileHoles = 0;
+    std::unordered_set<const ItemTile*> m_completedItemTiles;  // Eager mode only
+    QScrollArea* m_scrollArea = nullptr;
     QVBoxLayout* m_itemsLayout = nullptr;
+    VirtualItemList* m_virtualList = nullptr;
+    int m_overscan;
     QLabel* m_headerInfo = nullptr;
     QLabel* m_itemsPlaceholder = nullptr;
     
@@ -71,6 +221,14 @@ private:
     // Track last item count to avoid unnecessary header updates
     size_t m_lastItemCount = 0;
     
+    // Last reported progress, to emit progressChanged() only on change
+    int m_lastProgressCompleted = -1;
+    int m_lastProgressTotal = -1;
+    
+    // Batch update state
+    int m_batchDepth = 0;
+    int m_batchExpandedChanges = 0;
+    
     Q_DISABLE_COPY(GroupTile)
 };
 
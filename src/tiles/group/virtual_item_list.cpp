@@ -0,0 +1,532 @@
+#include "virtual_item_list.h"
+#include "../item/item_tile.h"
+#include <QScrollArea>
+#include <QScrollBar>
+#include <QLayout>
+#include <QEvent>
+#include <QTimer>
+#include <algorithm>
+
+namespace LongView {
+namespace Tiles {
+
+VirtualItemList::VirtualItemList(QWidget* parent)
+    : QWidget(parent)
+{
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+}
+
+VirtualItemList::~VirtualItemList() = default;
+
+void VirtualItemList::setItems(const std::vector<Config::Item>& items)
+{
+    releaseAllTiles();
+
+    m_rows.clear();
+    m_rows.reserve(items.size());
+    for (const auto& item : items) {
+        Row row;
+        row.item = item;
+        m_rows.push_back(std::move(row));
+    }
+    m_completedCount = 0;
+
+    rebuildHeightIndex();
+    scheduleRelayout();
+}
+
+void VirtualItemList::clear()
+{
+    setItems({});
+}
+
+bool VirtualItemList::moveItem(int from, int to)
+{
+    if (from < 0 || from >= count() || to < 0 || to >= count()) return false;
+    if (from == to) return true;
+
+    // Row indices of live tiles shift; rebind them on the next relayout
+    releaseAllTiles();
+    if (from < to) {
+        std::rotate(m_rows.begin() + from, m_rows.begin() + from + 1, m_rows.begin() + to + 1);
+    } else {
+        std::rotate(m_rows.begin() + to, m_rows.begin() + from, m_rows.begin() + from + 1);
+    }
+    rebuildHeightIndex();
+    scheduleRelayout();
+    return true;
+}
+
+void VirtualItemList::applyDiff(const std::vector<Config::Item>& items, const Config::ListDiff& diff,
+                                bool addedExpanded)
+{
+    // Removed rows give their tiles back while live tiles are still keyed by old row
+    for (int index : diff.removed) {
+        recycleTile(index);
+    }
+
+    std::vector<Row> rows;
+    rows.reserve(items.size());
+    std::map<int, ItemTile*> liveTiles;
+    std::vector<ItemTile*> reboundTiles;
+    m_completedCount = 0;
+    for (size_t i = 0; i < items.size(); ++i) {
+        const int index = static_cast<int>(i);
+        const int source = diff.sources[i];
+        if (source < 0) {
+            Row row;
+            row.item = items[i];
+            row.expanded = addedExpanded;
+            rows.push_back(std::move(row));
+            continue;
+        }
+
+        Row row = std::move(m_rows[source]);
+        const bool modified = diff.isModified(index);
+        if (modified) {
+            row.item = items[i];
+            row.measuredHeight[0] = row.measuredHeight[1] = -1;
+        }
+        m_completedCount += row.completed ? 1 : 0;
+
+        auto it = m_liveTiles.find(source);
+        if (it != m_liveTiles.end()) {
+            ItemTile* tile = it->second;
+            liveTiles[index] = tile;
+            m_tileRows[tile] = index;
+            if (modified) {
+                tile->bind(row.item);
+                reboundTiles.push_back(tile);
+            }
+        }
+        rows.push_back(std::move(row));
+    }
+
+    m_rows = std::move(rows);
+    m_liveTiles = std::move(liveTiles);
+    rebuildHeightIndex();
+    scheduleRelayout();
+
+    for (auto* tile : reboundTiles) {
+        emit tileAttached(tile);
+    }
+}
+
+int VirtualItemList::setAllExpanded(bool expanded)
+{
+    int changed = 0;
+    for (auto& row : m_rows) {
+        if (row.expanded != expanded) {
+            row.expanded = expanded;
+            ++changed;
+        }
+    }
+    if (changed == 0) return 0;
+
+    for (const auto& [index, tile] : m_liveTiles) {
+        tile->restoreState(expanded, m_rows[index].completed);
+    }
+    rebuildHeightIndex();
+    scheduleRelayout();
+    return changed;
+}
+
+int VirtualItemList::setAllCompleted(bool completed)
+{
+    const int changed = completed ? count() - m_completedCount : m_completedCount;
+    if (changed == 0) return 0;
+
+    for (auto& row : m_rows) {
+        row.completed = completed;
+    }
+    m_completedCount = completed ? count() : 0;
+    for (const auto& [index, tile] : m_liveTiles) {
+        tile->restoreState(m_rows[index].expanded, completed);
+    }
+    return changed;
+}
+
+int VirtualItemList::setCompletedWhere(const std::function<bool(const Config::Item&)>& predicate, bool completed)
+{
+    int changed = 0;
+    for (auto& row : m_rows) {
+        if (row.completed != completed && predicate(row.item)) {
+            row.completed = completed;
+            ++changed;
+        }
+    }
+    if (changed == 0) return 0;
+
+    m_completedCount += completed ? changed : -changed;
+    for (const auto& [index, tile] : m_liveTiles) {
+        tile->restoreState(m_rows[index].expanded, m_rows[index].completed);
+    }
+    return changed;
+}
+
+void VirtualItemList::attachToScrollArea(QScrollArea* scrollArea)
+{
+    if (m_scrollArea) {
+        m_scrollArea->viewport()->removeEventFilter(this);
+        disconnect(m_scrollArea->verticalScrollBar(), nullptr, this, nullptr);
+        disconnect(m_scrollArea->horizontalScrollBar(), nullptr, this, nullptr);
+    }
+
+    m_scrollArea = scrollArea;
+    if (!m_scrollArea) return;
+
+    m_scrollArea->viewport()->installEventFilter(this);
+    connect(m_scrollArea->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &VirtualItemList::updateFromScrollArea);
+    connect(m_scrollArea->horizontalScrollBar(), &QScrollBar::valueChanged,
+            this, &VirtualItemList::updateFromScrollArea);
+    updateFromScrollArea();
+}
+
+void VirtualItemList::setVisibleRect(const QRect& rect)
+{
+    if (m_visibleRect == rect) return;
+    m_visibleRect = rect;
+    relayout();
+}
+
+void VirtualItemList::setOverscan(int pixels)
+{
+    pixels = std::max(0, pixels);
+    if (m_overscan == pixels) return;
+    m_overscan = pixels;
+    scheduleRelayout();
+}
+
+void VirtualItemList::setSpacing(int spacing)
+{
+    spacing = std::max(0, spacing);
+    if (m_spacing == spacing) return;
+    m_spacing = spacing;
+    rebuildHeightIndex();
+    scheduleRelayout();
+}
+
+void VirtualItemList::refreshLiveTiles()
+{
+    // Rows without a live tile have nothing to refresh; they are rebuilt
+    // with fresh content when they scroll back into view
+    for (const auto& [index, tile] : m_liveTiles) {
+        Q_UNUSED(index);
+        tile->refresh();
+    }
+}
+
+QSize VirtualItemList::sizeHint() const
+{
+    return QSize(minimumWidth(), totalHeight());
+}
+
+QSize VirtualItemList::minimumSizeHint() const
+{
+    return QSize(0, totalHeight());
+}
+
+bool VirtualItemList::eventFilter(QObject* watched, QEvent* event)
+{
+    if (m_scrollArea && watched == m_scrollArea->viewport() && event->type() == QEvent::Resize) {
+        updateFromScrollArea();
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void VirtualItemList::resizeEvent(QResizeEvent* event)
+{
+    QWidget::resizeEvent(event);
+    updateFromScrollArea();
+    relayout();
+}
+
+void VirtualItemList::moveEvent(QMoveEvent* event)
+{
+    QWidget::moveEvent(event);
+    updateFromScrollArea();
+}
+
+void VirtualItemList::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    updateFromScrollArea();
+    scheduleRelayout();
+}
+
+void VirtualItemList::hideEvent(QHideEvent* event)
+{
+    QWidget::hideEvent(event);
+    // Hidden lists (e.g. collapsed group) keep no live tiles around
+    releaseAllTiles();
+}
+
+int VirtualItemList::rowHeight(int index) const
+{
+    const Row& row = m_rows[index];
+    const int measured = row.measuredHeight[row.expanded ? 1 : 0];
+    return measured >= 0 ? measured : ItemTile::estimatedHeight(row.item, row.expanded);
+}
+
+void VirtualItemList::rebuildHeightIndex()
+{
+    const int oldTotal = totalHeight();
+    const size_t n = m_rows.size();
+
+    m_heights.resize(n);
+    m_tree.assign(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        m_heights[i] = rowHeight(static_cast<int>(i));
+        m_tree[i + 1] += m_heights[i] + m_spacing;
+        // O(n) Fenwick construction: push partial sum to the parent node
+        const size_t parent = (i + 1) + ((i + 1) & (~(i + 1) + 1));
+        if (parent <= n) {
+            m_tree[parent] += m_tree[i + 1];
+        }
+    }
+
+    if (totalHeight() != oldTotal) {
+        updateGeometry();
+    }
+}
+
+void VirtualItemList::setRowHeight(int index, int height)
+{
+    const int delta = height - m_heights[index];
+    if (delta == 0) return;
+
+    m_heights[index] = height;
+    const size_t n = m_rows.size();
+    for (size_t i = static_cast<size_t>(index) + 1; i <= n; i += i & (~i + 1)) {
+        m_tree[i] += delta;
+    }
+
+    // Keep the visible content anchored when a row above the viewport changes height
+    if (m_scrollArea && rowTop(index) < m_visibleRect.top()) {
+        auto* bar = m_scrollArea->verticalScrollBar();
+        bar->setValue(bar->value() + delta);
+    }
+    updateGeometry();
+}
+
+int VirtualItemList::rowTop(int index) const
+{
+    int sum = 0;
+    for (size_t i = static_cast<size_t>(index); i > 0; i -= i & (~i + 1)) {
+        sum += m_tree[i];
+    }
+    return sum;
+}
+
+int VirtualItemList::rowAt(int y) const
+{
+    const size_t n = m_rows.size();
+    if (n == 0) return -1;
+
+    // Fenwick descent: count of rows whose bottom edge (incl. spacing) is <= y
+    size_t pos = 0;
+    size_t step = 1;
+    while (step * 2 <= n) step *= 2;
+    int remaining = y;
+    for (; step > 0; step /= 2) {
+        if (pos + step <= n && m_tree[pos + step] <= remaining) {
+            pos += step;
+            remaining -= m_tree[pos];
+        }
+    }
+    return static_cast<int>(std::min(pos, n - 1));
+}
+
+int VirtualItemList::totalHeight() const
+{
+    // Based on the tree rather than m_rows, which may already have been resized
+    if (m_tree.size() <= 1) return 0;
+    return rowTop(static_cast<int>(m_tree.size()) - 1) - m_spacing;
+}
+
+void VirtualItemList::updateFromScrollArea()
+{
+    if (!m_scrollArea) return;
+    updateVisibleRect(m_scrollArea->viewport());
+}
+
+void VirtualItemList::updateVisibleRect(const QWidget* viewport)
+{
+    if (!viewport || !isVisible() || !viewport->isAncestorOf(this)) {
+        setVisibleRect(QRect());
+        return;
+    }
+    const QPoint origin = mapFrom(viewport, QPoint(0, 0));
+    setVisibleRect(QRect(origin, viewport->size()) & rect());
+}
+
+void VirtualItemList::scheduleRelayout()
+{
+    if (m_relayoutPending) return;
+    m_relayoutPending = true;
+    QTimer::singleShot(0, this, [this]() {
+        m_relayoutPending = false;
+        relayout();
+    });
+}
+
+void VirtualItemList::relayout()
+{
+    if (m_inRelayout) {
+        scheduleRelayout();
+        return;
+    }
+    m_inRelayout = true;
+
+    if (m_rows.empty() || !isVisible() || m_visibleRect.isEmpty()) {
+        releaseAllTiles();
+        m_inRelayout = false;
+        return;
+    }
+
+    // Measuring freshly materialized tiles can change row heights, which in
+    // turn changes the visible range; a couple of passes settle it
+    constexpr int kMaxPasses = 3;
+    for (int pass = 0; pass < kMaxPasses; ++pass) {
+        const int top = std::max(0, m_visibleRect.top() - m_overscan);
+        const int bottom = m_visibleRect.bottom() + m_overscan;
+        const int first = rowAt(top);
+        const int last = rowAt(bottom);
+
+        // Recycle tiles that left the range
+        for (auto it = m_liveTiles.begin(); it != m_liveTiles.end();) {
+            const int index = it->first;
+            ++it;
+            if (index < first || index > last) {
+                recycleTile(index);
+            }
+        }
+
+        // Materialize and measure rows entering the range
+        bool heightsChanged = false;
+        for (int index = first; index <= last; ++index) {
+            auto it = m_liveTiles.find(index);
+            ItemTile* tile = it != m_liveTiles.end() ? it->second : acquireTile(index);
+            const int before = m_heights[index];
+            measureTile(index, tile);
+            heightsChanged = heightsChanged || m_heights[index] != before;
+        }
+        if (!heightsChanged) break;
+    }
+
+    // Position live tiles
+    for (const auto& [index, tile] : m_liveTiles) {
+        tile->setGeometry(0, rowTop(index), width(), m_heights[index]);
+    }
+
+    m_inRelayout = false;
+}
+
+ItemTile* VirtualItemList::acquireTile(int index)
+{
+    const Row& row = m_rows[index];
+
+    ItemTile* tile = nullptr;
+    if (!m_pool.empty()) {
+        tile = m_pool.back();
+        m_pool.pop_back();
+        tile->bind(row.item);
+    } else {
+        tile = new ItemTile(row.item, this);
+    }
+    tile->restoreState(row.expanded, row.completed);
+
+    connect(tile, &Tile::expandedChanged, this, [this, tile](bool expanded) {
+        onTileExpandedChanged(tile, expanded);
+    });
+    connect(tile, &Tile::completedChanged, this, [this, tile](bool completed) {
+        onTileCompletedChanged(tile, completed);
+    });
+
+    m_liveTiles[index] = tile;
+    m_tileRows[tile] = index;
+    tile->show();
+    emit tileAttached(tile);
+    return tile;
+}
+
+void VirtualItemList::recycleTile(int index)
+{
+    auto it = m_liveTiles.find(index);
+    if (it == m_liveTiles.end()) return;
+
+    ItemTile* tile = it->second;
+    m_liveTiles.erase(it);
+    m_tileRows.erase(tile);
+    emit tileDetached(tile);
+    QObject::disconnect(tile, nullptr, this, nullptr);
+    // The row left the viewport; its content is not needed anymore
+    tile->cancelLoads();
+    tile->hide();
+
+    if (m_pool.size() < kMaxPooledTiles) {
+        m_pool.push_back(tile);
+    } else {
+        tile->deleteLater();
+    }
+}
+
+void VirtualItemList::releaseAllTiles()
+{
+    while (!m_liveTiles.empty()) {
+        recycleTile(m_liveTiles.begin()->first);
+    }
+}
+
+void VirtualItemList::measureTile(int index, ItemTile* tile)
+{
+    // Tiles are positioned only after measuring, so measure at the row
+    // width rather than at whatever width a fresh or recycled tile has
+    const int rowWidth = width();
+    if (auto* layout = tile->layout()) {
+        layout->activate();
+    }
+    int height = -1;
+    if (tile->hasHeightForWidth()) {
+        height = tile->heightForWidth(rowWidth);
+    }
+    if (height < 0) {
+        height = tile->sizeHint().height();
+        if (auto* layout = tile->layout()) {
+            height = std::max(height, layout->totalMinimumSize().height());
+        }
+    }
+    height = std::clamp(height, tile->minimumHeight(), tile->maximumHeight());
+
+    Row& row = m_rows[index];
+    row.measuredHeight[row.expanded ? 1 : 0] = height;
+    setRowHeight(index, height);
+}
+
+void VirtualItemList::onTileExpandedChanged(ItemTile* tile, bool expanded)
+{
+    auto it = m_tileRows.find(tile);
+    if (it == m_tileRows.end()) return;
+
+    const int index = it->second;
+    m_rows[index].expanded = expanded;
+    setRowHeight(index, rowHeight(index));
+    scheduleRelayout();
+    emit itemExpandedChanged(index, expanded);
+}
+
+void VirtualItemList::onTileCompletedChanged(ItemTile* tile, bool completed)
+{
+    auto it = m_tileRows.find(tile);
+    if (it == m_tileRows.end()) return;
+
+    const int index = it->second;
+    if (m_rows[index].completed == completed) return;
+    m_rows[index].completed = completed;
+    m_completedCount += completed ? 1 : -1;
+    emit itemCompletedChanged(index, completed);
+}
+
+} // namespace Tiles
+} // namespace LongView
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "../../config/config.h"
+#include "../../config/config_diff.h"
+#include <QWidget>
+#include <QPointer>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations
+class QScrollArea;
+class QEvent;
+
+namespace LongView {
+namespace Tiles {
+
+class ItemTile;
+
+/**
+ * @brief Viewport-virtualized list of ItemTiles used by GroupTile
+ *
+ * Holds the config items and their expanded/completed state as plain data and
+ * only materializes ItemTiles for the rows intersecting the visible rect
+ * (plus an overscan margin). Row heights start as estimates and are replaced
+ * by measured heights once a row has been laid out, so the widget's total
+ * height (and therefore the scroll range) stays correct. Tiles scrolled out
+ * of range are recycled through a small pool and rebound to other items.
+ */
+class VirtualItemList final : public QWidget {
+    Q_OBJECT
+    Q_DISABLE_COPY(VirtualItemList)
+
+public:
+    static constexpr int kDefaultOverscan = 480;  // pixels above and below the viewport
+    static constexpr int kDefaultSpacing = 8;
+
+    explicit VirtualItemList(QWidget* parent = nullptr);
+    ~VirtualItemList() override;
+
+    // Model
+    void setItems(const std::vector<Config::Item>& items);
+    void clear();
+    bool moveItem(int from, int to);
+
+    /**
+     * @brief Replace the items with @p items, changed from the current ones as described by @p diff
+     *
+     * Rows keep their state, measured heights and live tiles across the
+     * change; only the live tiles of modified rows are rebound, losing their
+     * content, and reported through tileAttached() again.
+     * @param addedExpanded Expanded state of added rows
+     */
+    void applyDiff(const std::vector<Config::Item>& items, const Config::ListDiff& diff, bool addedExpanded);
+
+    int count() const { return static_cast<int>(m_rows.size()); }
+    int completedCount() const { return m_completedCount; }
+    const Config::Item& itemAt(int index) const { return m_rows[index].item; }
+    bool isItemExpanded(int index) const { return m_rows[index].expanded; }
+    bool isItemCompleted(int index) const { return m_rows[index].completed; }
+
+    // Bulk state changes - applied to model and live tiles without per-row signals.
+    // Both return the number of rows whose state actually changed.
+    int setAllExpanded(bool expanded);
+    int setAllCompleted(bool completed);
+    int setCompletedWhere(const std::function<bool(const Config::Item&)>& predicate, bool completed);
+
+    // Viewport handling
+    /**
+     * @brief Track the viewport of a scroll area that (indirectly) contains this list
+     *
+     * Scrolling and viewport resizes then update the visible rect automatically.
+     */
+    void attachToScrollArea(QScrollArea* scrollArea);
+
+    /**
+     * @brief Set the visible part of this list in its own coordinates
+     *
+     * Used by scroll surfaces that do not move this widget directly.
+     */
+    void setVisibleRect(const QRect& rect);
+    
+    /**
+     * @brief Derive the visible rect from an ancestor viewport widget
+     */
+    void updateVisibleRect(const QWidget* viewport);
+
+    void setOverscan(int pixels);
+    int overscan() const { return m_overscan; }
+    void setSpacing(int spacing);
+
+    // Live tiles, keyed by row index
+    const std::map<int, ItemTile*>& liveTiles() const { return m_liveTiles; }
+    void refreshLiveTiles();
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+signals:
+    void itemExpandedChanged(int index, bool expanded);
+    void itemCompletedChanged(int index, bool completed);
+    // A tile was bound to a row / is about to be recycled
+    void tileAttached(LongView::Tiles::ItemTile* tile);
+    void tileDetached(LongView::Tiles::ItemTile* tile);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void moveEvent(QMoveEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private:
+    static constexpr size_t kMaxPooledTiles = 32;
+
+    struct Row {
+        Config::Item item;
+        bool expanded = false;
+        bool completed = false;
+        int measuredHeight[2] = {-1, -1};  // [collapsed, expanded], -1 until laid out
+    };
+
+    // Height index (Fenwick tree over row extents = height + spacing)
+    int rowHeight(int index) const;
+    void rebuildHeightIndex();
+    void setRowHeight(int index, int height);
+    int rowTop(int index) const;
+    int rowAt(int y) const;
+    int totalHeight() const;
+
+    // Materialization
+    void updateFromScrollArea();
+    void scheduleRelayout();
+    void relayout();
+    ItemTile* acquireTile(int index);
+    void recycleTile(int index);
+    void releaseAllTiles();
+    void measureTile(int index, ItemTile* tile);
+    void onTileExpandedChanged(ItemTile* tile, bool expanded);
+    void onTileCompletedChanged(ItemTile* tile, bool completed);
+
+    std::vector<Row> m_rows;
+    std::vector<int> m_heights;   // current height per row (estimated or measured)
+    std::vector<int> m_tree;      // Fenwick tree of m_heights[i] + m_spacing
+    int m_completedCount = 0;
+
+    std::map<int, ItemTile*> m_liveTiles;
+    std::unordered_map<ItemTile*, int> m_tileRows;
+    std::vector<ItemTile*> m_pool;
+
+    QPointer<QScrollArea> m_scrollArea;
+    QRect m_visibleRect;
+    int m_overscan = kDefaultOverscan;
+    int m_spacing = kDefaultSpacing;
+    bool m_relayoutPending = false;
+    bool m_inRelayout = false;
+};
+
+} // namespace Tiles
+} // namespace LongView
@@ -1,14 +1,60 @@
 #include "item_tile.h"
-
-#include <QLabel>
+#include "../../views/content_view.h"
+#include "../../views/view_factory.h"
 #include <QVBoxLayout>
 
+#include <algorithm>
+
 namespace LongView {
 namespace Tiles {
 
 ItemTile::ItemTile(const LongView::Config::Item& item, QWidget* parent)
     : Tile(Tile::Kind::Item, parent)
     , m_item(item)
+{
+    applyItem();
+}
+
+ItemTile::~ItemTile()
+{
+    // Hand the content view back to the pool before it is deleted with us
+    setContentWidget(nullptr);
+}
+
+void ItemTile::bind(const LongView::Config::Item& item)
+{
+    // Loads for the old item must not land in the new one
+    cancelLoads();
+    m_item = item;
+    // Returns the old view to the pool, reset; content is rebuilt from the pool
+    setContentWidget(nullptr);
+    applyItem();
+    
+    // A recycled tile may already be expanded on screen
+    if (isExpanded() && isVisible()) {
+        ensureContent();
+    }
+}
+
+QSize ItemTile::sizeHint() const
+{
+    // Expanded content (an image, a sized page) can be taller than the default
+    const int height = m_mainLayout ? m_mainLayout->sizeHint().height() : Tile::kDefaultHeight;
+    return QSize(Tile::kDefaultWidth, std::max(height, Tile::kDefaultHeight));
+}
+
+int ItemTile::estimatedHeight(const LongView::Config::Item& item, bool expanded)
+{
+    // Collapsed and expanded tiles both report the default size hint;
+    // an explicit item size can only make an expanded tile taller
+    if (expanded && item.size.has_value()) {
+        const int header = kButtonSize + kSpacing + 2 * kMargin;
+        return std::max(kDefaultHeight, item.size->height + header);
+    }
+    return kDefaultHeight;
+}
+
+void ItemTile::applyItem()
 {
     // Title: use item.name if present, else a generic label
     const QString title = m_item.name.has_value()
@@ -23,48 +69,69 @@ ItemTile::ItemTile(const LongView::Config::Item& item, QWidget* parent)
                .arg(tr("n/a"))
                .arg(val.left(200) + (val.size() > 200 ? "..." : "")));
 
-    buildContent();
-    applyOptionalProperties();
+    // Content is built on first expansion via createContent()
 }
 
 void ItemTile::refresh()
 {
-    // MVP: no-op; future: delegate to inner view (e.g., WebView reload)
+    // Nothing to refresh for a tile that has never been expanded
+    if (auto* view = contentView()) {
+        view->reload();
+    }
 }
 
-void ItemTile::buildContent()
+void ItemTile::updateLoadPriority()
 {
-    // MVP placeholder content; real content will come from ViewFactory later
-    auto* content = new QWidget(this);
-    auto* vbox = new QVBoxLayout(content);
-    vbox->setContentsMargins(0, 0, 0, 0);
-    vbox->setSpacing(kSpacing);
-
-    auto* info = new QLabel(content);
-    info->setTextFormat(Qt::PlainText);
-    const auto val = QString::fromStdString(m_item.value);
-    info->setText(tr("Item placeholder\nValue: %1").arg(val.left(160)));
-    info->setTextInteractionFlags(Qt::TextSelectableByMouse);
-    info->setWordWrap(true);
+    if (auto* view = contentView()) {
+        view->updatePriority();
+    }
+}
+
+void ItemTile::cancelLoads()
+{
+    if (auto* view = contentView()) {
+        view->cancel();
+    }
+}
+
+Views::ContentView* ItemTile::contentView() const
+{
+    return qobject_cast<Views::ContentView*>(contentWidget());
+}
 
-    vbox->addWidget(info);
-    vbox->addStretch();
+void ItemTile::createContent()
+{
+    auto& factory = Views::ViewFactory::getInstance();
+    if (auto* view = factory.acquire(m_item, this)) {
+        setContentWidget(view);
+        return;
+    }
 
-    setContentWidget(content);
+    // Too many heavy views alive; try again once one has been released
+    if (factory.isHeavy(m_item.type)) {
+        connect(&factory, &Views::ViewFactory::heavyViewReleased, this, &ItemTile::retryContent,
+                Qt::UniqueConnection);
+    }
+}
+
+void ItemTile::retryContent()
+{
+    disconnect(&Views::ViewFactory::getInstance(), &Views::ViewFactory::heavyViewReleased,
+               this, &ItemTile::retryContent);
+    // Otherwise the next show or expansion builds the content
+    if (isExpanded() && isVisible()) {
+        ensureContent();
+    }
 }
 
-void ItemTile::applyOptionalProperties()
+void ItemTile::discardContent(QWidget* widget)
 {
-    // TODO: when ViewFactory is integrated, remove this minimum size here
-    // and delegate size handling to the specific XxxView via applySize().
-    // Apply optional size to the content widget (not the Tile itself)
-    if (m_item.size.has_value()) {
-        const auto s = m_item.size.value();
-        if (auto* cw = contentWidget()) {
-            cw->setMinimumSize(s.width, s.height);
-        }
+    // Views go back to the factory's pool instead of being deleted
+    if (auto* view = qobject_cast<Views::ContentView*>(widget)) {
+        Views::ViewFactory::getInstance().release(view);
+        return;
     }
-    // refresh_frequency will be handled by concrete views in future steps
+    Tile::discardContent(widget);
 }
 
 } // namespace Tiles
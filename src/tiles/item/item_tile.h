@@ -4,6 +4,11 @@
 #include "../../config/config.h"  // Need complete type for value member Item
 
 namespace LongView {
+
+namespace Views {
+class ContentView;
+}
+
 namespace Tiles {
 
 class ItemTile final : public Tile {
@@ -12,17 +17,51 @@ class ItemTile final : public Tile {
 
 public:
     explicit ItemTile(const LongView::Config::Item& item, QWidget* parent = nullptr);
-    ~ItemTile() override = default;
+    ~ItemTile() override;
 
-    void refresh() override; // MVP: no-op for now
+    void refresh() override; // No-op until content has been built
+    QSize sizeHint() const override;
 
     const LongView::Config::Item& item() const { return m_item; }
 
+    /**
+     * @brief Rebind this tile to a different config item
+     * 
+     * Cancels loads in flight, replaces title and tooltip and drops the old
+     * content so a tile instance can be recycled (e.g. by a virtualized
+     * GroupTile) instead of destroyed and recreated. New content is built
+     * lazily like for a fresh tile.
+     * Expanded/completed state is left untouched; use restoreState() for that.
+     */
+    void bind(const LongView::Config::Item& item);
+
+    /**
+     * @brief Let pending content loads know where the tile is relative to the screen
+     */
+    void updateLoadPriority();
+
+    /**
+     * @brief Abort content loads in flight, e.g. before the tile is removed or recycled
+     */
+    void cancelLoads();
+
+    /**
+     * @brief Estimated tile height for an item before it has been laid out
+     * @param item The config item the tile would show
+     * @param expanded Whether the tile would be expanded
+     */
+    static int estimatedHeight(const LongView::Config::Item& item, bool expanded);
+
+protected:
+    void createContent() override;
+    void discardContent(QWidget* widget) override;
+
 private:
-    void buildContent();
-    void applyOptionalProperties();
+    Views::ContentView* contentView() const;
+    void retryContent();
+    void applyItem();
 
-    const LongView::Config::Item m_item;
+    LongView::Config::Item m_item;
 };
 
 } // namespace Tiles
@@ -0,0 +1,14 @@
+#include "content_view.h"
+
+namespace LongView {
+namespace Views {
+
+ContentView::ContentView(QWidget* parent)
+    : QWidget(parent)
+{
+}
+
+ContentView::~ContentView() = default;
+
+} // namespace Views
+} // namespace LongView
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../config/config.h"
+#include <QWidget>
+
+namespace LongView {
+namespace Views {
+
+/**
+ * @brief Base class of the content views ItemTiles show for their item
+ *
+ * Content views are created and recycled by ViewFactory. A view is bound to
+ * an item, and reset before it goes back into the factory's pool, so one
+ * instance can show many items over its lifetime. Loading hooks default to
+ * no-ops for views without asynchronous content.
+ */
+class ContentView : public QWidget {
+    Q_OBJECT
+    Q_DISABLE_COPY(ContentView)
+
+public:
+    explicit ContentView(QWidget* parent = nullptr);
+    ~ContentView() override;
+
+    /**
+     * @brief Show @p item; called on new and on recycled views alike
+     */
+    virtual void bind(const Config::Item& item) = 0;
+
+    /**
+     * @brief Drop everything specific to the bound item
+     *
+     * Must leave the view as cheap as possible to keep in a pool: pending
+     * loads cancelled, decoded content released.
+     */
+    virtual void reset() = 0;
+
+    /**
+     * @brief Load the content again, e.g. on a scheduled refresh
+     */
+    virtual void reload() {}
+
+    /**
+     * @brief Re-rank pending loads after the view moved relative to the screen
+     */
+    virtual void updatePriority() {}
+
+    /**
+     * @brief Abort pending loads
+     */
+    virtual void cancel() {}
+};
+
+} // namespace Views
+} // namespace LongView
@@ -0,0 +1,276 @@
+#include "html_view.h"
+#ifdef LONGVIEW_WEBENGINE
+#include "web_view.h"
+#endif
+#include <QAbstractTextDocumentLayout>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QEvent>
+#include <QHash>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QRegularExpression>
+#include <QSet>
+#include <QTextDocument>
+#include <QVBoxLayout>
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <vector>
+
+namespace LongView {
+namespace Views {
+
+namespace {
+    constexpr int kMaxCachedLayouts = 64;
+    constexpr int kDefaultWidth = 360;
+
+    HtmlView::Statistics s_statistics;
+
+    /**
+     * @brief LRU cache of laid out documents (GUI thread only)
+     */
+    class LayoutCache {
+    public:
+        static LayoutCache& getInstance()
+        {
+            static LayoutCache instance;
+            return instance;
+        }
+
+        std::shared_ptr<QTextDocument> document(const QString& html, int width, const QFont& font)
+        {
+            const QString key = QString::number(qHash(html)) + '/' + QString::number(html.size()) + '/'
+                              + QString::number(width) + '/' + font.key();
+            auto it = m_index.find(key);
+            if (it != m_index.end() && it.value()->html == html) {
+                ++s_statistics.layoutHits;
+                m_entries.splice(m_entries.begin(), m_entries, it.value());
+                return it.value()->document;
+            }
+
+            ++s_statistics.layoutMisses;
+            auto document = std::make_shared<QTextDocument>();
+            document->setDocumentMargin(0);
+            document->setDefaultFont(font);
+            document->setHtml(html);
+            document->setTextWidth(width);
+            // Lay out now, once, instead of on first paint in every view
+            document->size();
+
+            if (it != m_index.end()) {
+                m_entries.erase(it.value());
+            }
+            m_entries.push_front({key, html, document});
+            m_index.insert(key, m_entries.begin());
+            while (static_cast<int>(m_entries.size()) > kMaxCachedLayouts) {
+                m_index.remove(m_entries.back().key);
+                m_entries.pop_back();
+            }
+            return document;
+        }
+
+    private:
+        LayoutCache()
+        {
+            // Documents are QObjects; drop them while the application still exists
+            QObject::connect(qApp, &QCoreApplication::aboutToQuit, [this]() {
+                m_index.clear();
+                m_entries.clear();
+            });
+        }
+
+        struct Entry {
+            QString key;
+            QString html;  // Guards against hash collisions
+            std::shared_ptr<QTextDocument> document;
+        };
+
+        std::list<Entry> m_entries;  // Most recently used first
+        QHash<QString, std::list<Entry>::iterator> m_index;
+    };
+
+    struct BrowserFeature {
+        QRegularExpression pattern;
+        const char* reason;
+    };
+
+    const std::vector<BrowserFeature>& browserFeatures()
+    {
+        static const std::vector<BrowserFeature> features = {
+            {QRegularExpression(R"(<script\b)", QRegularExpression::CaseInsensitiveOption), "script"},
+            {QRegularExpression(R"(\son[a-z]+\s*=)", QRegularExpression::CaseInsensitiveOption), "event handler"},
+            {QRegularExpression(R"(javascript:)", QRegularExpression::CaseInsensitiveOption), "javascript: URL"},
+            {QRegularExpression(R"(<(iframe|object|embed|canvas|video|audio|svg)\b)",
+                                QRegularExpression::CaseInsensitiveOption), "embedded content"},
+            {QRegularExpression(R"(<(form|input|select|textarea|button)\b)",
+                                QRegularExpression::CaseInsensitiveOption), "form controls"},
+            {QRegularExpression(R"(<link\b|@import|\bsrc\s*=\s*["']?(https?:)?//)",
+                                QRegularExpression::CaseInsensitiveOption), "remote resources"},
+        };
+        return features;
+    }
+
+    // Report each slow fragment once, not on every rebind
+    void reportBrowserPath(const QString& html, const QString& reason)
+    {
+        static QSet<size_t> reported;
+        const size_t hash = qHash(html);
+        if (reported.contains(hash)) return;
+        reported.insert(hash);
+        qInfo().noquote() << "IFrame fragment needs a browser (" + reason + "):"
+                          << html.simplified().left(80);
+    }
+}
+
+HtmlView::HtmlView(QWidget* parent)
+    : ContentView(parent)
+    , m_layout(new QVBoxLayout(this))
+{
+    m_layout->setContentsMargins(0, 0, 0, 0);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+}
+
+HtmlView::~HtmlView() = default;
+
+void HtmlView::bind(const Config::Item& item)
+{
+    m_html = QString::fromStdString(item.value);
+    m_size = item.size;
+    if (m_size) {
+        setFixedSize(m_size->width, m_size->height);
+    } else {
+        setMinimumSize(0, 0);
+        setMaximumSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+    }
+
+    Classification classification = classify(m_html);
+#ifndef LONGVIEW_WEBENGINE
+    if (classification.path == RenderPath::Browser) {
+        // No browser engine in this build: render what rich text can
+        classification.reason += QStringLiteral(", rendered as rich text without Qt WebEngine");
+        classification.path = RenderPath::RichText;
+        reportBrowserPath(m_html, classification.reason);
+    }
+#endif
+    m_path = classification.path;
+
+    if (m_path == RenderPath::Browser) {
+        ++s_statistics.browser;
+        reportBrowserPath(m_html, classification.reason);
+#ifdef LONGVIEW_WEBENGINE
+        if (!m_webView) {
+            m_webView = new WebView(this);
+            m_layout->addWidget(m_webView);
+        }
+        m_webView->bindHtml(m_html, std::nullopt);
+        m_webView->show();
+#endif
+    } else {
+        ++s_statistics.richText;
+        if (m_webView) {
+            m_webView->reset();
+            m_webView->hide();
+        }
+    }
+
+    updateGeometry();
+    update();
+}
+
+void HtmlView::reset()
+{
+    if (m_webView) {
+        m_webView->reset();
+        m_webView->hide();
+    }
+    m_html.clear();
+    m_size.reset();
+    m_path = RenderPath::RichText;
+    setMinimumSize(0, 0);
+    setMaximumSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+}
+
+void HtmlView::reload()
+{
+    // Static fragments do not change between refreshes
+    if (m_path == RenderPath::Browser && m_webView) {
+        m_webView->reload();
+    }
+}
+
+void HtmlView::cancel()
+{
+    if (m_webView) {
+        m_webView->cancel();
+    }
+}
+
+HtmlView::Classification HtmlView::classify(const QString& html)
+{
+    const QString trimmed = html.trimmed();
+    // Not a fragment but the address of a page to embed
+    if (!trimmed.contains('<')) {
+        return {RenderPath::Browser, QStringLiteral("URL")};
+    }
+
+    for (const BrowserFeature& feature : browserFeatures()) {
+        if (feature.pattern.match(html).hasMatch()) {
+            return {RenderPath::Browser, QString::fromLatin1(feature.reason)};
+        }
+    }
+    return {RenderPath::RichText, QString()};
+}
+
+HtmlView::Statistics HtmlView::statistics()
+{
+    return s_statistics;
+}
+
+bool HtmlView::hasHeightForWidth() const
+{
+    return m_path == RenderPath::RichText && !m_size;
+}
+
+int HtmlView::heightForWidth(int width) const
+{
+    if (m_path != RenderPath::RichText || m_html.isEmpty()) return ContentView::heightForWidth(width);
+    return static_cast<int>(std::ceil(document(width)->size().height()));
+}
+
+QSize HtmlView::sizeHint() const
+{
+    if (m_size) return QSize(m_size->width, m_size->height);
+    if (m_path == RenderPath::Browser) return ContentView::sizeHint();
+    const int width = this->width() > 0 ? this->width() : kDefaultWidth;
+    return QSize(width, heightForWidth(width));
+}
+
+void HtmlView::paintEvent(QPaintEvent* event)
+{
+    if (m_path != RenderPath::RichText || m_html.isEmpty()) return;
+
+    QPainter painter(this);
+    QAbstractTextDocumentLayout::PaintContext context;
+    context.palette = palette();
+    context.clip = event->rect();
+    document(width())->documentLayout()->draw(&painter, context);
+}
+
+void HtmlView::changeEvent(QEvent* event)
+{
+    ContentView::changeEvent(event);
+    // Cached layouts are keyed by font; a new font means a new height
+    if (event->type() == QEvent::FontChange) {
+        updateGeometry();
+        update();
+    }
+}
+
+std::shared_ptr<QTextDocument> HtmlView::document(int width) const
+{
+    return LayoutCache::getInstance().document(m_html, std::max(1, width), font());
+}
+
+} // namespace Views
+} // namespace LongView
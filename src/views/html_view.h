@@ -0,0 +1,88 @@
+#pragma once
+
+#include "content_view.h"
+#include <QString>
+#include <memory>
+#include <optional>
+
+// Forward declarations
+class QTextDocument;
+class QVBoxLayout;
+
+namespace LongView {
+namespace Views {
+
+class WebView;
+
+/**
+ * @brief Content view for Config::Type::IFrame items (HTML fragments)
+ *
+ * Most fragments are static tables and KPI summaries, which are rendered
+ * with a QTextDocument instead of a browser engine. Laid out documents are
+ * kept in a small cache keyed by fragment, width and font, so tiles showing
+ * the same fragment, recycled views and repeated height queries reuse one
+ * layout.
+ *
+ * Fragments that need a browser (scripts, event handlers, embedded or
+ * remote content) are shown in a WebView instead, when Qt WebEngine is
+ * available. The path taken is exposed through renderPath(), counted in
+ * statistics(), and logged once per fragment that misses the fast path.
+ */
+class HtmlView final : public ContentView {
+    Q_OBJECT
+    Q_DISABLE_COPY(HtmlView)
+
+public:
+    enum class RenderPath { RichText, Browser };
+    Q_ENUM(RenderPath)
+
+    struct Classification {
+        RenderPath path = RenderPath::RichText;
+        QString reason;  // Why a browser is needed; empty for RichText
+    };
+
+    struct Statistics {
+        quint64 richText = 0;
+        quint64 browser = 0;
+        quint64 layoutHits = 0;
+        quint64 layoutMisses = 0;
+    };
+
+    explicit HtmlView(QWidget* parent = nullptr);
+    ~HtmlView() override;
+
+    // ContentView
+    void bind(const Config::Item& item) override;
+    void reset() override;
+    void reload() override;
+    void cancel() override;
+
+    RenderPath renderPath() const { return m_path; }
+
+    /**
+     * @brief Decide whether a fragment can be rendered as rich text
+     */
+    static Classification classify(const QString& html);
+
+    static Statistics statistics();
+
+    bool hasHeightForWidth() const override;
+    int heightForWidth(int width) const override;
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void changeEvent(QEvent* event) override;
+
+private:
+    std::shared_ptr<QTextDocument> document(int width) const;
+
+    QString m_html;
+    std::optional<Config::Size> m_size;
+    RenderPath m_path = RenderPath::RichText;
+    QVBoxLayout* m_layout = nullptr;
+    WebView* m_webView = nullptr;  // Created on first use by a browser fragment
+};
+
+} // namespace Views
+} // namespace LongView
@@ -0,0 +1,240 @@
+#include "image_view.h"
+#include <QHideEvent>
+#include <QPainter>
+#include <QResizeEvent>
+#include <QShowEvent>
+#include <QTimer>
+#include <cmath>
+
+namespace LongView {
+namespace Views {
+
+namespace {
+    // Resizes settle before an image is decoded again at the new size
+    constexpr int kResizeReloadDelay = 200;
+    // Only re-decode when the view outgrew the decoded image noticeably
+    constexpr double kUpscaleTolerance = 1.25;
+    constexpr int kDefaultHeight = 160;
+    // Hidden only briefly (e.g. a tile flickering at the viewport edge) keeps the load
+    constexpr int kHiddenCancelDelay = 500;
+}
+
+ImageView::ImageView(QWidget* parent)
+    : ContentView(parent)
+    , m_resizeTimer(new QTimer(this))
+    , m_cancelTimer(new QTimer(this))
+{
+    m_status = tr("Loading...");
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+
+    m_resizeTimer->setSingleShot(true);
+    m_resizeTimer->setInterval(kResizeReloadDelay);
+    connect(m_resizeTimer, &QTimer::timeout, this, &ImageView::loadIfNeeded);
+
+    m_cancelTimer->setSingleShot(true);
+    m_cancelTimer->setInterval(kHiddenCancelDelay);
+    connect(m_cancelTimer, &QTimer::timeout, this, &ImageView::cancel);
+}
+
+ImageView::~ImageView()
+{
+    delete m_reply;
+}
+
+void ImageView::bind(const Config::Item& item)
+{
+    applySize(item.size);
+    setSource(QString::fromStdString(item.value));
+}
+
+void ImageView::reset()
+{
+    cancel();
+    m_resizeTimer->stop();
+    m_source.clear();
+    m_image = QImage();
+    m_decodedTarget = QSize();
+    m_status = tr("Loading...");
+    applySize(std::nullopt);
+}
+
+void ImageView::setSource(const QString& source)
+{
+    if (source == m_source) return;
+    m_source = source;
+    m_image = QImage();
+    m_decodedTarget = QSize();
+    m_status = tr("Loading...");
+    update();
+
+    if (isVisible()) {
+        load(Content::ImageLoader::CachePolicy::PreferCache);
+    }
+}
+
+void ImageView::applySize(const std::optional<Config::Size>& size)
+{
+    m_size = size;
+    if (m_size) {
+        setFixedSize(m_size->width, m_size->height);
+    } else {
+        setMinimumSize(0, 0);
+        setMaximumSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+    }
+    updateGeometry();
+}
+
+void ImageView::reload()
+{
+    load(Content::ImageLoader::CachePolicy::Refresh);
+}
+
+void ImageView::load(Content::ImageLoader::CachePolicy policy)
+{
+    if (m_source.isEmpty()) return;
+
+    // A newer request supersedes the one in flight
+    delete m_reply;
+    m_reply = Content::ImageLoader::getInstance().load(m_source, targetSize(), this, policy, loadPriority());
+    connect(m_reply, &Content::ImageReply::finished, this, &ImageView::onReplyFinished);
+}
+
+void ImageView::updatePriority()
+{
+    if (m_reply) {
+        m_reply->setPriority(loadPriority());
+    }
+}
+
+void ImageView::cancel()
+{
+    m_cancelTimer->stop();
+    // Deleting the reply aborts it; the next show loads again if still needed
+    delete m_reply;
+}
+
+QSize ImageView::sizeHint() const
+{
+    if (m_size) return QSize(m_size->width, m_size->height);
+    if (!m_image.isNull()) return m_image.deviceIndependentSize().toSize();
+    return QSize(ContentView::sizeHint().width(), kDefaultHeight);
+}
+
+void ImageView::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+
+    if (m_image.isNull()) {
+        painter.setPen(palette().color(QPalette::PlaceholderText));
+        painter.drawText(rect(), Qt::AlignCenter | Qt::TextWordWrap, m_status);
+        return;
+    }
+
+    // Decoded for this size already; only scale down if the view shrank
+    QSizeF imageSize = m_image.deviceIndependentSize();
+    if (imageSize.width() > width() || imageSize.height() > height()) {
+        imageSize = imageSize.scaled(size(), Qt::KeepAspectRatio);
+    }
+    QRectF target(QPointF(0, 0), imageSize);
+    target.moveCenter(QRectF(rect()).center());
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, imageSize != m_image.deviceIndependentSize());
+    painter.drawImage(target, m_image);
+}
+
+void ImageView::resizeEvent(QResizeEvent* event)
+{
+    ContentView::resizeEvent(event);
+    if (!m_size && isVisible()) {
+        m_resizeTimer->start();
+    }
+}
+
+void ImageView::showEvent(QShowEvent* event)
+{
+    ContentView::showEvent(event);
+    // First load once the layout has given the view its real size
+    m_cancelTimer->stop();
+    QTimer::singleShot(0, this, &ImageView::loadIfNeeded);
+    updatePriority();
+}
+
+void ImageView::hideEvent(QHideEvent* event)
+{
+    ContentView::hideEvent(event);
+    updatePriority();
+    if (m_reply) {
+        m_cancelTimer->start();
+    }
+}
+
+void ImageView::loadIfNeeded()
+{
+    if (!isVisible() || m_reply) return;
+    // Without a configured size, wait until the view has one to decode for
+    if (!m_size && size().isEmpty()) return;
+    if (m_image.isNull() || needsLargerImage()) {
+        load(Content::ImageLoader::CachePolicy::PreferCache);
+    }
+}
+
+QSize ImageView::targetSize() const
+{
+    const QSize logical = m_size ? QSize(m_size->width, m_size->height) : size();
+    if (logical.isEmpty()) return QSize();
+    const qreal dpr = devicePixelRatioF();
+    return QSize(static_cast<int>(std::ceil(logical.width() * dpr)),
+                 static_cast<int>(std::ceil(logical.height() * dpr)));
+}
+
+Network::Priority ImageView::loadPriority() const
+{
+    if (!isVisible()) return Network::Priority::Offscreen;
+    // Shown but clipped away entirely: laid out in an overscan margin
+    if (visibleRegion().isEmpty()) return Network::Priority::Overscan;
+    return Network::Priority::Visible;
+}
+
+bool ImageView::needsLargerImage() const
+{
+    // A full-size decode (invalid target) cannot get any sharper
+    const QSize target = targetSize();
+    if (m_image.isNull() || !target.isValid() || !m_decodedTarget.isValid()) return false;
+    return target.width() > m_decodedTarget.width() * kUpscaleTolerance
+        || target.height() > m_decodedTarget.height() * kUpscaleTolerance;
+}
+
+void ImageView::onReplyFinished()
+{
+    Content::ImageReply* reply = m_reply;
+    m_reply = nullptr;
+    if (!reply) return;
+    reply->deleteLater();
+
+    if (reply->image().isNull()) {
+        // Keep showing the previous image if a refresh failed
+        if (m_image.isNull()) {
+            m_status = tr("Failed to load image\n%1").arg(reply->errorString());
+            update();
+        }
+        return;
+    }
+
+    const QSize oldSize = m_image.deviceIndependentSize().toSize();
+    m_image = reply->image();
+    m_decodedTarget = reply->targetSize();
+    m_image.setDevicePixelRatio(devicePixelRatioF());
+    if (m_image.deviceIndependentSize().toSize() != oldSize) {
+        updateGeometry();
+    }
+    update();
+    emit imageChanged();
+
+    // Previous run's snapshot: keep showing it while fetching the current content
+    if (reply->isStale()) {
+        reload();
+    }
+}
+
+} // namespace Views
+} // namespace LongView
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "content_view.h"
+#include "../content/image_loader.h"
+#include <QImage>
+#include <QPointer>
+#include <QString>
+#include <optional>
+
+// Forward declarations
+class QTimer;
+
+namespace LongView {
+
+namespace Views {
+
+/**
+ * @brief Content view for Config::Type::Image items
+ *
+ * Loads its source through Content::ImageLoader, decoded at the configured
+ * item size (or its own size) times the device pixel ratio, and paints the
+ * ready image without further scaling. Loading never blocks the GUI thread;
+ * a status line is shown until the first image arrives or on error.
+ * Loads are prioritized by how much of the view is on screen. A load still
+ * pending when the view has been hidden for a moment (scrolled past, tile
+ * collapsed) is cancelled and started again when the view is shown.
+ */
+class ImageView final : public ContentView {
+    Q_OBJECT
+    Q_DISABLE_COPY(ImageView)
+
+public:
+    explicit ImageView(QWidget* parent = nullptr);
+    ~ImageView() override;
+
+    // ContentView
+    void bind(const Config::Item& item) override;
+    void reset() override;
+
+    void setSource(const QString& source);
+    QString source() const { return m_source; }
+
+    /**
+     * @brief Fix the displayed size to the item's configured size, if any
+     */
+    void applySize(const std::optional<Config::Size>& size);
+
+    /**
+     * @brief Load the source again, keeping the current image until the new one is ready
+     * 
+     * Bypasses the shared content cache, so a refresh always shows fresh content.
+     */
+    void reload() override;
+
+    const QImage& image() const { return m_image; }
+    bool isLoading() const { return m_reply != nullptr; }
+
+    /**
+     * @brief Re-rank a pending load after the view moved relative to the screen
+     */
+    void updatePriority() override;
+
+    /**
+     * @brief Drop the pending load, aborting its download and decoding if nobody else needs them
+     */
+    void cancel() override;
+
+    QSize sizeHint() const override;
+
+signals:
+    void imageChanged();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private:
+    QSize targetSize() const;
+    Network::Priority loadPriority() const;
+    bool needsLargerImage() const;
+    void loadIfNeeded();
+    void load(Content::ImageLoader::CachePolicy policy);
+    void onReplyFinished();
+
+    QString m_source;
+    std::optional<Config::Size> m_size;
+    QImage m_image;
+    QSize m_decodedTarget;  // Target size m_image was decoded for
+    QString m_status;
+    QPointer<Content::ImageReply> m_reply;
+    QTimer* m_resizeTimer = nullptr;
+    QTimer* m_cancelTimer = nullptr;
+};
+
+} // namespace Views
+} // namespace LongView
@@ -0,0 +1,48 @@
+#include "placeholder_view.h"
+#include <QLabel>
+#include <QVBoxLayout>
+
+namespace LongView {
+namespace Views {
+
+namespace {
+    constexpr int kMaxValueLength = 160;
+}
+
+PlaceholderView::PlaceholderView(QWidget* parent)
+    : ContentView(parent)
+    , m_label(new QLabel(this))
+{
+    auto* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    m_label->setTextFormat(Qt::PlainText);
+    m_label->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    m_label->setWordWrap(true);
+
+    layout->addWidget(m_label);
+    layout->addStretch();
+}
+
+PlaceholderView::~PlaceholderView() = default;
+
+void PlaceholderView::bind(const Config::Item& item)
+{
+    const auto value = QString::fromStdString(item.value);
+    m_label->setText(tr("Item placeholder\nValue: %1").arg(value.left(kMaxValueLength)));
+
+    if (item.size) {
+        setMinimumSize(item.size->width, item.size->height);
+    } else {
+        setMinimumSize(0, 0);
+    }
+}
+
+void PlaceholderView::reset()
+{
+    m_label->clear();
+    setMinimumSize(0, 0);
+}
+
+} // namespace Views
+} // namespace LongView
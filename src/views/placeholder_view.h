@@ -0,0 +1,32 @@
+#pragma once
+
+#include "content_view.h"
+
+// Forward declarations
+class QLabel;
+
+namespace LongView {
+namespace Views {
+
+/**
+ * @brief Stand-in content for item types without a real view yet
+ *
+ * Shows the item's value as plain text.
+ */
+class PlaceholderView final : public ContentView {
+    Q_OBJECT
+    Q_DISABLE_COPY(PlaceholderView)
+
+public:
+    explicit PlaceholderView(QWidget* parent = nullptr);
+    ~PlaceholderView() override;
+
+    void bind(const Config::Item& item) override;
+    void reset() override;
+
+private:
+    QLabel* m_label = nullptr;
+};
+
+} // namespace Views
+} // namespace LongView
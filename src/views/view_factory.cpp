@@ -0,0 +1,203 @@
+#include "view_factory.h"
+#include "content_view.h"
+#include "html_view.h"
+#include "image_view.h"
+#include "placeholder_view.h"
+#ifdef LONGVIEW_WEBENGINE
+#include "web_view.h"
+#endif
+#include <QCoreApplication>
+#include <algorithm>
+
+namespace LongView {
+namespace Views {
+
+ViewFactory& ViewFactory::getInstance()
+{
+    static ViewFactory instance;
+    return instance;
+}
+
+ViewFactory::ViewFactory()
+    : QObject(nullptr)
+{
+    bool ok = false;
+    const int maxHeavy = qEnvironmentVariableIntValue("LONGVIEW_MAX_HEAVY_VIEWS", &ok);
+    if (ok && maxHeavy > 0) {
+        m_maxHeavyViews = maxHeavy;
+    }
+
+    // Pooled views are widgets; they must be gone before the application object
+    if (auto* app = QCoreApplication::instance()) {
+        connect(app, &QCoreApplication::aboutToQuit, this, [this]() {
+            m_shuttingDown = true;
+            clearPools();
+        });
+    }
+
+    registerBuiltinTypes();
+}
+
+ViewFactory::~ViewFactory() = default;
+
+void ViewFactory::registerBuiltinTypes()
+{
+    registerType(Config::Type::Image, [](QWidget* parent) { return new ImageView(parent); });
+#ifdef LONGVIEW_WEBENGINE
+    // Light without a page; WebPagePool bounds the live browser pages
+    registerType(Config::Type::Web, [](QWidget* parent) { return new WebView(parent); });
+#else
+    // A label; nothing to cap
+    registerType(Config::Type::Web, [](QWidget* parent) { return new PlaceholderView(parent); });
+#endif
+    registerType(Config::Type::IFrame, [](QWidget* parent) { return new HtmlView(parent); });
+}
+
+void ViewFactory::registerType(Config::Type type, Creator create, int poolCapacity, bool heavy)
+{
+    TypeEntry& entry = m_types[type];
+    // Pooled views of a replaced implementation would be handed out again
+    for (ContentView* view : entry.pool) {
+        delete view;
+    }
+    entry.pool.clear();
+    entry.statistics.pooled = 0;
+
+    entry.create = std::move(create);
+    entry.poolCapacity = std::max(0, poolCapacity);
+    entry.heavy = heavy;
+}
+
+bool ViewFactory::isRegistered(Config::Type type) const
+{
+    auto it = m_types.find(type);
+    return it != m_types.end() && it->second.create;
+}
+
+bool ViewFactory::isHeavy(Config::Type type) const
+{
+    auto it = m_types.find(type);
+    return it != m_types.end() && it->second.heavy;
+}
+
+ContentView* ViewFactory::acquire(const Config::Item& item, QWidget* parent)
+{
+    auto it = m_types.find(item.type);
+    if (it == m_types.end() || !it->second.create) return nullptr;
+
+    TypeEntry& entry = it->second;
+    if (entry.heavy && m_liveHeavy >= m_maxHeavyViews) {
+        ++entry.statistics.denials;
+        return nullptr;
+    }
+
+    ContentView* view = nullptr;
+    if (!entry.pool.empty()) {
+        view = entry.pool.back();
+        entry.pool.pop_back();
+        --entry.statistics.pooled;
+        ++entry.statistics.poolHits;
+        view->setParent(parent);
+    } else {
+        view = entry.create(parent);
+        ++entry.statistics.creations;
+    }
+
+    m_live[view] = item.type;
+    ++entry.statistics.live;
+    if (entry.heavy) {
+        ++m_liveHeavy;
+    }
+    // Views deleted along with their tile never come back through release()
+    connect(view, &QObject::destroyed, this, &ViewFactory::forgetLive, Qt::UniqueConnection);
+
+    view->bind(item);
+    return view;
+}
+
+void ViewFactory::release(ContentView* view)
+{
+    if (!view) return;
+
+    auto live = m_live.find(view);
+    if (live == m_live.end()) {
+        // Not ours (or released twice); nothing to recycle
+        view->deleteLater();
+        return;
+    }
+    const Config::Type type = live->second;
+    // Frees the heavy view slot, if any
+    forgetLive(view);
+    disconnect(view, &QObject::destroyed, this, &ViewFactory::forgetLive);
+
+    TypeEntry& entry = m_types[type];
+    ++entry.statistics.releases;
+
+    view->reset();
+    view->hide();
+    if (m_shuttingDown || static_cast<int>(entry.pool.size()) >= entry.poolCapacity) {
+        ++entry.statistics.discards;
+        view->deleteLater();
+    } else {
+        view->setParent(nullptr);
+        entry.pool.push_back(view);
+        ++entry.statistics.pooled;
+    }
+}
+
+void ViewFactory::setMaxHeavyViews(int count)
+{
+    const bool raised = count > m_maxHeavyViews;
+    m_maxHeavyViews = std::max(1, count);
+    if (raised) {
+        emit heavyViewReleased();
+    }
+}
+
+ViewFactory::Statistics ViewFactory::statistics(Config::Type type) const
+{
+    auto it = m_types.find(type);
+    return it != m_types.end() ? it->second.statistics : Statistics();
+}
+
+void ViewFactory::resetStatistics()
+{
+    for (auto& [type, entry] : m_types) {
+        // Gauges describe the current state and are kept
+        Statistics reset;
+        reset.live = entry.statistics.live;
+        reset.pooled = entry.statistics.pooled;
+        entry.statistics = reset;
+    }
+}
+
+void ViewFactory::clearPools()
+{
+    for (auto& [type, entry] : m_types) {
+        for (ContentView* view : entry.pool) {
+            delete view;
+        }
+        entry.pool.clear();
+        entry.statistics.pooled = 0;
+    }
+}
+
+void ViewFactory::forgetLive(const QObject* view)
+{
+    auto it = m_live.find(view);
+    if (it == m_live.end()) return;
+
+    TypeEntry& entry = m_types[it->second];
+    --entry.statistics.live;
+    if (entry.heavy) {
+        --m_liveHeavy;
+        // A view deleted with its tile frees a slot as well
+        if (!m_shuttingDown) {
+            QMetaObject::invokeMethod(this, &ViewFactory::heavyViewReleased, Qt::QueuedConnection);
+        }
+    }
+    m_live.erase(it);
+}
+
+} // namespace Views
+} // namespace LongView
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "../config/config.h"
+#include <QObject>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations
+class QWidget;
+
+namespace LongView {
+namespace Views {
+
+class ContentView;
+
+/**
+ * @brief Creates and recycles the content views of item tiles
+ *
+ * A registry maps each Config::Type to a view implementation. Views given
+ * back through release() are reset and kept in a per-type pool, so tiles
+ * that are virtualized, recycled or rebuilt rebind an existing view instead
+ * of constructing a new one.
+ *
+ * Types registered as heavy (e.g. browser views) are capped in the number of
+ * views alive at once. Once the cap is reached acquire() returns nullptr, and
+ * heavyViewReleased() tells waiting tiles when to try again. The cap can be
+ * overridden with the LONGVIEW_MAX_HEAVY_VIEWS environment variable.
+ *
+ * GUI thread only.
+ */
+class ViewFactory : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int kDefaultPoolCapacity = 16;  // Pooled views per type
+    static constexpr int kDefaultMaxHeavyViews = 8;
+
+    using Creator = std::function<ContentView*(QWidget* parent)>;
+
+    struct Statistics {
+        quint64 creations = 0;
+        quint64 poolHits = 0;
+        quint64 releases = 0;
+        quint64 discards = 0;  // Released while the pool was full
+        quint64 denials = 0;   // acquire() calls refused by the heavy view cap
+        int live = 0;          // Views handed out and not released
+        int pooled = 0;
+    };
+
+    // Singleton pattern
+    static ViewFactory& getInstance();
+
+    ViewFactory(const ViewFactory&) = delete;
+    ViewFactory& operator=(const ViewFactory&) = delete;
+
+    /**
+     * @brief Register (or replace) the view implementation for @p type
+     * @param poolCapacity Views kept for reuse once released
+     * @param heavy Whether live views of this type count against the heavy view cap
+     */
+    void registerType(Config::Type type, Creator create, int poolCapacity = kDefaultPoolCapacity,
+                      bool heavy = false);
+    bool isRegistered(Config::Type type) const;
+    bool isHeavy(Config::Type type) const;
+
+    /**
+     * @brief A view bound to @p item, from the pool if possible
+     * @return nullptr if the type is not registered or the heavy view cap is reached
+     */
+    ContentView* acquire(const Config::Item& item, QWidget* parent);
+
+    /**
+     * @brief Reset @p view and keep it for reuse, or delete it if the pool is full
+     *
+     * The caller must have removed the view from its layout.
+     */
+    void release(ContentView* view);
+
+    void setMaxHeavyViews(int count);
+    int maxHeavyViews() const { return m_maxHeavyViews; }
+    int liveHeavyViews() const { return m_liveHeavy; }
+
+    Statistics statistics(Config::Type type) const;
+    void resetStatistics();
+
+    /**
+     * @brief Delete all pooled views
+     */
+    void clearPools();
+
+signals:
+    /**
+     * @brief A heavy view was released; acquire() may succeed again
+     */
+    void heavyViewReleased();
+
+private:
+    ViewFactory();
+    ~ViewFactory() override;
+
+    struct TypeEntry {
+        Creator create;
+        int poolCapacity = kDefaultPoolCapacity;
+        bool heavy = false;
+        std::vector<ContentView*> pool;
+        Statistics statistics;
+    };
+
+    void registerBuiltinTypes();
+    void forgetLive(const QObject* view);
+
+    std::unordered_map<Config::Type, TypeEntry> m_types;
+    std::unordered_map<const QObject*, Config::Type> m_live;  // Handed-out views
+    int m_maxHeavyViews = kDefaultMaxHeavyViews;
+    int m_liveHeavy = 0;
+    bool m_shuttingDown = false;
+};
+
+} // namespace Views
+} // namespace LongView
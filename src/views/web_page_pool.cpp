@@ -0,0 +1,166 @@
+#include "web_page_pool.h"
+#include "web_view.h"
+#include <QApplication>
+#include <QWebEnginePage>
+#include <QWebEngineProfile>
+#include <QWebEngineView>
+#include <algorithm>
+
+namespace LongView {
+namespace Views {
+
+namespace {
+    const QString kProfileName = QStringLiteral("LongView");
+}
+
+WebPagePool& WebPagePool::getInstance()
+{
+    static WebPagePool instance;
+    return instance;
+}
+
+void WebPagePool::configureEngine()
+{
+    // Required by Qt WebEngine before the application object exists
+    QCoreApplication::setAttribute(Qt::AA_ShareOpenGLContexts);
+
+    // Pages of one site share a renderer process instead of one process per page
+    QByteArray flags = qgetenv("QTWEBENGINE_CHROMIUM_FLAGS");
+    if (!flags.contains("--process-per")) {
+        flags += flags.isEmpty() ? "--process-per-site" : " --process-per-site";
+        qputenv("QTWEBENGINE_CHROMIUM_FLAGS", flags);
+    }
+}
+
+WebPagePool::WebPagePool()
+    : QObject(nullptr)
+{
+    bool ok = false;
+    const int maxPages = qEnvironmentVariableIntValue("LONGVIEW_MAX_WEB_PAGES", &ok);
+    if (ok && maxPages > 0) {
+        m_maxLivePages = maxPages;
+    }
+
+    // Owned by the application so it outlives every page, including those
+    // still attached to views when the main window is destroyed
+    m_profile = new QWebEngineProfile(kProfileName, QCoreApplication::instance());
+    m_profile->setHttpCacheType(QWebEngineProfile::DiskHttpCache);
+
+    connect(qApp, &QCoreApplication::aboutToQuit, this, [this]() {
+        m_shuttingDown = true;
+        clearIdlePages();
+    });
+}
+
+WebPagePool::~WebPagePool() = default;
+
+QWebEngineView* WebPagePool::acquire(WebView* client)
+{
+    QWebEngineView* page = nullptr;
+    if (!m_idle.empty()) {
+        page = m_idle.back();
+        m_idle.pop_back();
+    } else if (m_statistics.live < m_maxLivePages) {
+        page = createPage();
+    } else {
+        page = evictHiddenPage();
+    }
+
+    if (!page) {
+        ++m_statistics.denials;
+        return nullptr;
+    }
+
+    ++m_statistics.activations;
+    m_holders.push_front(client);
+    m_holderIndex[client] = m_holders.begin();
+    return page;
+}
+
+void WebPagePool::touch(WebView* client)
+{
+    auto it = m_holderIndex.find(client);
+    if (it == m_holderIndex.end()) return;
+    m_holders.splice(m_holders.begin(), m_holders, it->second);
+}
+
+void WebPagePool::release(WebView* client)
+{
+    auto it = m_holderIndex.find(client);
+    if (it == m_holderIndex.end()) return;
+    m_holders.erase(it->second);
+    m_holderIndex.erase(it);
+
+    QWebEngineView* page = client->suspend();
+    if (!page) {
+        --m_statistics.live;
+        return;
+    }
+    if (m_shuttingDown) {
+        --m_statistics.live;
+        delete page;
+        return;
+    }
+
+    // Drop the old document so an idle page holds no renderer memory
+    page->setUrl(QUrl(QStringLiteral("about:blank")));
+    m_idle.push_back(page);
+    trimIdlePages();
+    QMetaObject::invokeMethod(this, &WebPagePool::pageAvailable, Qt::QueuedConnection);
+}
+
+void WebPagePool::setMaxLivePages(int count)
+{
+    const bool raised = count > m_maxLivePages;
+    m_maxLivePages = std::max(1, count);
+    trimIdlePages();
+    if (raised) {
+        emit pageAvailable();
+    }
+}
+
+QWebEngineView* WebPagePool::createPage()
+{
+    auto* view = new QWebEngineView();
+    view->setPage(new QWebEnginePage(m_profile, view));
+    ++m_statistics.creations;
+    ++m_statistics.live;
+    return view;
+}
+
+QWebEngineView* WebPagePool::evictHiddenPage()
+{
+    // Least recently used first; pages on screen are never taken away
+    for (auto it = m_holders.rbegin(); it != m_holders.rend(); ++it) {
+        WebView* holder = *it;
+        if (holder->isOnScreen()) continue;
+
+        m_holderIndex.erase(holder);
+        m_holders.erase(std::next(it).base());
+        ++m_statistics.evictions;
+        return holder->suspend();
+    }
+    return nullptr;
+}
+
+void WebPagePool::trimIdlePages()
+{
+    // Idle pages count against the cap as well (e.g. after it was lowered)
+    while (!m_idle.empty() && m_statistics.live > m_maxLivePages) {
+        delete m_idle.back();
+        m_idle.pop_back();
+        --m_statistics.live;
+    }
+}
+
+void WebPagePool::clearIdlePages()
+{
+    for (QWebEngineView* page : m_idle) {
+        delete page;
+    }
+    m_statistics.live -= static_cast<int>(m_idle.size());
+    m_idle.clear();
+}
+
+} // namespace Views
+} // namespace LongView
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QObject>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations
+class QWebEngineProfile;
+class QWebEngineView;
+
+namespace LongView {
+namespace Views {
+
+class WebView;
+
+/**
+ * @brief Bounded set of live browser pages shared by all web tiles
+ *
+ * A browser page is by far the heaviest content a tile can have, so their
+ * number is capped (LONGVIEW_MAX_WEB_PAGES, default kDefaultMaxLivePages)
+ * regardless of how many web items a configuration has. WebViews borrow a
+ * page while they are shown; when the cap is reached, the page of the least
+ * recently used WebView that is not on screen is taken away from it, and
+ * that view falls back to showing its last snapshot until it is shown again.
+ *
+ * All pages use one profile, so cookies, HTTP cache and renderer processes
+ * are shared. GUI thread only.
+ */
+class WebPagePool : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int kDefaultMaxLivePages = 4;
+
+    struct Statistics {
+        quint64 activations = 0;  // Pages handed to a view
+        quint64 creations = 0;
+        quint64 evictions = 0;    // Pages taken from a hidden view
+        quint64 denials = 0;      // Requests refused because every page was on screen
+        int live = 0;             // Pages in existence, attached or idle
+    };
+
+    // Singleton pattern
+    static WebPagePool& getInstance();
+
+    WebPagePool(const WebPagePool&) = delete;
+    WebPagePool& operator=(const WebPagePool&) = delete;
+
+    /**
+     * @brief Prepare the browser engine; call before the QApplication is created
+     */
+    static void configureEngine();
+
+    QWebEngineProfile* profile() const { return m_profile; }
+
+    /**
+     * @brief A page for @p client, which becomes the most recently used holder
+     * @return nullptr if the cap is reached and every page is on screen;
+     *         pageAvailable() is emitted when trying again makes sense
+     */
+    QWebEngineView* acquire(WebView* client);
+
+    /**
+     * @brief Mark @p client's page as most recently used
+     */
+    void touch(WebView* client);
+
+    /**
+     * @brief Take back the page of @p client, if it holds one
+     */
+    void release(WebView* client);
+
+    void setMaxLivePages(int count);
+    int maxLivePages() const { return m_maxLivePages; }
+
+    Statistics statistics() const { return m_statistics; }
+
+signals:
+    void pageAvailable();
+
+private:
+    WebPagePool();
+    ~WebPagePool() override;
+
+    QWebEngineView* createPage();
+    QWebEngineView* evictHiddenPage();
+    void trimIdlePages();
+    void clearIdlePages();
+
+    QWebEngineProfile* m_profile = nullptr;
+    std::list<WebView*> m_holders;  // Most recently used first
+    std::unordered_map<const WebView*, std::list<WebView*>::iterator> m_holderIndex;
+    std::vector<QWebEngineView*> m_idle;
+    int m_maxLivePages = kDefaultMaxLivePages;
+    bool m_shuttingDown = false;
+    Statistics m_statistics;
+};
+
+} // namespace Views
+} // namespace LongView
@@ -0,0 +1,231 @@
+#include "web_view.h"
+#include "web_page_pool.h"
+#include "../content/content_cache.h"
+#include <QCryptographicHash>
+#include <QPainter>
+#include <QShowEvent>
+#include <QTimer>
+#include <QVBoxLayout>
+#include <QWebEngineView>
+
+namespace LongView {
+namespace Views {
+
+namespace {
+    // Give the page time to render before it is captured
+    constexpr int kSnapshotDelay = 1000;
+    constexpr int kDefaultHeight = 320;
+}
+
+WebView::WebView(QWidget* parent)
+    : ContentView(parent)
+    , m_layout(new QVBoxLayout(this))
+    , m_snapshotTimer(new QTimer(this))
+{
+    m_layout->setContentsMargins(0, 0, 0, 0);
+    m_status = tr("Loading...");
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+
+    m_snapshotTimer->setSingleShot(true);
+    m_snapshotTimer->setInterval(kSnapshotDelay);
+    connect(m_snapshotTimer, &QTimer::timeout, this, &WebView::takeSnapshot);
+}
+
+WebView::~WebView()
+{
+    // The page is not ours; hand it back before it would be deleted with us
+    WebPagePool::getInstance().release(this);
+}
+
+void WebView::bind(const Config::Item& item)
+{
+    m_url = QUrl::fromUserInput(QString::fromStdString(item.value));
+    m_html.clear();
+    applySize(item.size);
+    m_snapshot = Content::ContentCache::getInstance().find({Content::ContentCache::Kind::Snapshot, snapshotKey(), QSize()});
+    m_status = tr("Loading...");
+    updateGeometry();
+    update();
+    activate();
+}
+
+void WebView::bindHtml(const QString& html, const std::optional<Config::Size>& size)
+{
+    m_url.clear();
+    m_html = html;
+    applySize(size);
+    m_snapshot = Content::ContentCache::getInstance().find({Content::ContentCache::Kind::Snapshot, snapshotKey(), QSize()});
+    m_status = tr("Loading...");
+    updateGeometry();
+    update();
+    activate();
+}
+
+void WebView::applySize(const std::optional<Config::Size>& size)
+{
+    m_size = size;
+    if (m_size) {
+        setFixedSize(m_size->width, m_size->height);
+    } else {
+        setMinimumSize(0, 0);
+        setMaximumSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+    }
+}
+
+void WebView::reset()
+{
+    WebPagePool::getInstance().release(this);
+    if (m_waitingForPage) {
+        disconnect(&WebPagePool::getInstance(), &WebPagePool::pageAvailable, this, &WebView::activate);
+        m_waitingForPage = false;
+    }
+    m_snapshotTimer->stop();
+    m_url.clear();
+    m_html.clear();
+    m_snapshot = QImage();
+    applySize(std::nullopt);
+}
+
+void WebView::reload()
+{
+    // Without a page, the next activation loads the current content anyway
+    if (!m_page) return;
+    if (m_html.isEmpty()) {
+        m_page->reload();
+    } else {
+        m_page->setHtml(m_html);
+    }
+}
+
+void WebView::cancel()
+{
+    if (m_page) {
+        m_page->stop();
+    }
+}
+
+void WebView::updatePriority()
+{
+    activate();
+}
+
+bool WebView::isOnScreen() const
+{
+    return isVisible() && !visibleRegion().isEmpty();
+}
+
+QSize WebView::sizeHint() const
+{
+    if (m_size) return QSize(m_size->width, m_size->height);
+    return QSize(ContentView::sizeHint().width(), kDefaultHeight);
+}
+
+void WebView::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+    // A live page covers the whole view
+    if (m_page) return;
+
+    QPainter painter(this);
+    if (m_snapshot.isNull()) {
+        painter.setPen(palette().color(QPalette::PlaceholderText));
+        painter.drawText(rect(), Qt::AlignCenter | Qt::TextWordWrap, m_status);
+        return;
+    }
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    painter.drawImage(rect(), m_snapshot);
+}
+
+void WebView::showEvent(QShowEvent* event)
+{
+    ContentView::showEvent(event);
+    // Views are shown before the layout places them; check once it has
+    QTimer::singleShot(0, this, &WebView::activate);
+}
+
+void WebView::activate()
+{
+    // Only views actually on screen take (and possibly evict) a page
+    if (!hasContent() || !isOnScreen()) return;
+
+    auto& pool = WebPagePool::getInstance();
+    if (m_page) {
+        pool.touch(this);
+        return;
+    }
+
+    QWebEngineView* page = pool.acquire(this);
+    if (!page) {
+        // Every live page is on screen; keep showing the snapshot meanwhile
+        if (!m_waitingForPage) {
+            connect(&pool, &WebPagePool::pageAvailable, this, &WebView::activate);
+            m_waitingForPage = true;
+        }
+        return;
+    }
+    if (m_waitingForPage) {
+        disconnect(&pool, &WebPagePool::pageAvailable, this, &WebView::activate);
+        m_waitingForPage = false;
+    }
+    attach(page);
+}
+
+void WebView::attach(QWebEngineView* page)
+{
+    m_page = page;
+    m_layout->addWidget(page);
+    page->show();
+
+    connect(page, &QWebEngineView::loadFinished, this, [this](bool ok) {
+        if (ok) {
+            m_snapshotTimer->start();
+        } else {
+            m_status = tr("Failed to load page");
+        }
+    });
+    // Pages come back from other views; always show this view's content
+    if (m_html.isEmpty()) {
+        page->setUrl(m_url);
+    } else {
+        page->setHtml(m_html);
+    }
+}
+
+QWebEngineView* WebView::suspend()
+{
+    QWebEngineView* page = m_page;
+    if (!page) return nullptr;
+
+    m_snapshotTimer->stop();
+    disconnect(page, nullptr, this, nullptr);
+    m_layout->removeWidget(page);
+    page->hide();
+    page->setParent(nullptr);
+    m_page = nullptr;
+    update();
+    return page;
+}
+
+void WebView::takeSnapshot()
+{
+    // Hidden pages do not render; keep the previous snapshot then
+    if (!m_page || !isOnScreen()) return;
+
+    const QImage snapshot = m_page->grab().toImage();
+    if (snapshot.isNull()) return;
+    m_snapshot = snapshot;
+    Content::ContentCache::getInstance().insert({Content::ContentCache::Kind::Snapshot, snapshotKey(), QSize()},
+                                                m_snapshot);
+}
+
+QString WebView::snapshotKey() const
+{
+    if (!m_html.isEmpty()) {
+        return QStringLiteral("html:")
+             + QString::fromLatin1(QCryptographicHash::hash(m_html.toUtf8(), QCryptographicHash::Sha1).toHex());
+    }
+    return m_url.toString(QUrl::FullyEncoded);
+}
+
+} // namespace Views
+} // namespace LongView
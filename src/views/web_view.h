@@ -0,0 +1,87 @@
+#pragma once
+
+#include "content_view.h"
+#include <QImage>
+#include <QPointer>
+#include <QString>
+#include <QUrl>
+#include <optional>
+
+// Forward declarations
+class QTimer;
+class QVBoxLayout;
+class QWebEngineView;
+
+namespace LongView {
+namespace Views {
+
+/**
+ * @brief Content view for Config::Type::Web items
+ *
+ * Borrows a live browser page from WebPagePool while it is on screen. When
+ * the pool takes the page away for another view, the last snapshot of the
+ * page is painted instead until the view is scrolled or shown into view
+ * again and gets a page back. Views that are merely shown in an overscan
+ * margin do not take a page.
+ * Snapshots are taken shortly after each load and kept in the ContentCache,
+ * so they also survive the view being recycled.
+ */
+class WebView final : public ContentView {
+    Q_OBJECT
+    Q_DISABLE_COPY(WebView)
+
+public:
+    explicit WebView(QWidget* parent = nullptr);
+    ~WebView() override;
+
+    // ContentView
+    void bind(const Config::Item& item) override;
+    void reset() override;
+    void reload() override;
+    void cancel() override;
+
+    /**
+     * @brief Take a page if the view has scrolled into view
+     */
+    void updatePriority() override;
+
+    /**
+     * @brief Show an HTML document instead of a URL, e.g. a scripted IFrame fragment
+     */
+    void bindHtml(const QString& html, const std::optional<Config::Size>& size);
+
+    QUrl url() const { return m_url; }
+    bool hasLivePage() const { return m_page != nullptr; }
+    bool isOnScreen() const;
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+
+private:
+    friend class WebPagePool;
+
+    void activate();
+    void attach(QWebEngineView* page);
+    // Detach and return the live page; called by the pool
+    QWebEngineView* suspend();
+    void takeSnapshot();
+    QString snapshotKey() const;
+    void applySize(const std::optional<Config::Size>& size);
+    bool hasContent() const { return !m_url.isEmpty() || !m_html.isEmpty(); }
+
+    QUrl m_url;
+    QString m_html;
+    std::optional<Config::Size> m_size;
+    QPointer<QWebEngineView> m_page;
+    QImage m_snapshot;
+    QString m_status;
+    QVBoxLayout* m_layout = nullptr;
+    QTimer* m_snapshotTimer = nullptr;
+    bool m_waitingForPage = false;
+};
+
+} // namespace Views
+} // namespace LongView